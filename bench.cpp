@@ -0,0 +1,733 @@
+// Benchmarks de los motores de main.cpp
+// Compilar: g++ -O2 -std=c++17 -pthread bench.cpp -o bench
+// Uso: ./bench <nombre> [parámetros...]
+#define SIN_MAIN
+#include "main.cpp"
+
+#include <chrono>
+#include <random>
+
+// Regresa los milisegundos que tarda en ejecutarse f()
+template <typename F>
+double medirMs(F f)
+{
+    auto inicio = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+// Grafo aleatorio conexo: un camino que pasa por todos los nodos más aristas al azar
+vector<Arista> grafoAleatorio(int N, size_t E, unsigned semilla)
+{
+    mt19937 gen(semilla);
+    uniform_int_distribution<int> nodo(0, N - 1), peso(1, 1000000);
+    vector<Arista> aristas;
+    aristas.reserve(E);
+    for (int i = 1; i < N; ++i)
+        aristas.emplace_back(i - 1, i, peso(gen));
+    while (aristas.size() < E)
+        aristas.emplace_back(nodo(gen), nodo(gen), peso(gen));
+    return aristas;
+}
+
+long long pesoTotal(const vector<Arista> &mst)
+{
+    long long total = 0;
+    for (const Arista &a : mst)
+        total += a.peso;
+    return total;
+}
+
+// Escalamiento de Filter-Kruskal con el número de hilos contra el Kruskal secuencial
+// Parámetros: N (nodos), E (aristas), máximo de hilos
+void benchFilterKruskal(int N, size_t E, int maxHilos)
+{
+    vector<Arista> aristas = grafoAleatorio(N, E, 42);
+
+    vector<Arista> referencia;
+    double msKruskal = medirMs([&]
+                               { referencia = kruskal(N, aristas); });
+    cout << "N=" << N << " E=" << E << endl;
+    cout << "kruskal         hilos=1  " << msKruskal << " ms  peso=" << pesoTotal(referencia) << endl;
+
+    for (int hilos = 1; hilos <= maxHilos; hilos *= 2)
+    {
+        numHilos = hilos;
+        vector<Arista> mst;
+        double ms = medirMs([&]
+                            { mst = filterKruskal(N, aristas); });
+        cout << "filter-kruskal  hilos=" << hilos << "  " << ms << " ms  peso=" << pesoTotal(mst)
+             << "  aceleracion=" << msKruskal / ms << (pesoTotal(mst) == pesoTotal(referencia) ? "" : "  ERROR") << endl;
+    }
+}
+
+// Escalamiento de Borůvka paralelo con el número de hilos contra el Kruskal secuencial
+// Parámetros: N (nodos), E (aristas), máximo de hilos
+void benchBoruvka(int N, size_t E, int maxHilos)
+{
+    vector<Arista> aristas = grafoAleatorio(N, E, 42);
+
+    vector<Arista> referencia;
+    double msKruskal = medirMs([&]
+                               { referencia = kruskal(N, aristas); });
+    cout << "N=" << N << " E=" << E << endl;
+    cout << "kruskal   hilos=1  " << msKruskal << " ms  peso=" << pesoTotal(referencia) << endl;
+
+    for (int hilos = 1; hilos <= maxHilos; hilos *= 2)
+    {
+        numHilos = hilos;
+        vector<Arista> mst;
+        double ms = medirMs([&]
+                            { mst = boruvkaParalelo(N, aristas); });
+        cout << "boruvka   hilos=" << hilos << "  " << ms << " ms  peso=" << pesoTotal(mst)
+             << "  aceleracion=" << msKruskal / ms << (pesoTotal(mst) == pesoTotal(referencia) ? "" : "  ERROR") << endl;
+    }
+}
+
+// Centrales aleatorias en un cuadrado de lado 'lado'
+vector<pair<int, int>> centralesAleatorias(int N, int lado, unsigned semilla)
+{
+    mt19937 gen(semilla);
+    uniform_int_distribution<int> coord(0, lado);
+    vector<pair<int, int>> centrales(N);
+    for (auto &c : centrales)
+        c = {coord(gen), coord(gen)};
+    return centrales;
+}
+
+// MST euclidiano con Delaunay contra Prim denso sobre la matriz completa (solo si N es manejable)
+// Parámetros: N máximo; se mide N = 1000, 2000, 4000, ...
+void benchDelaunay(int maxN)
+{
+    for (int N = 1000; N <= maxN; N *= 2)
+    {
+        vector<pair<int, int>> centrales = centralesAleatorias(N, 1000000, 7);
+        vector<Arista> mst;
+        double msDelaunay = medirMs([&]
+                                    { mst = mstDelaunay(centrales); });
+        cout << "N=" << N << "  delaunay " << msDelaunay << " ms  peso=" << pesoTotal(mst);
+        if (N <= 16000)
+        {
+            vector<int> matriz((size_t)N * N);
+            for (int i = 0; i < N; ++i)
+                for (int j = 0; j < N; ++j)
+                    matriz[(size_t)i * N + j] = pesoEuclidiano(centrales[i], centrales[j]);
+            vector<Arista> referencia;
+            double msPrim = medirMs([&]
+                                    { referencia = primDenso(N, matriz); });
+            cout << "  prim " << msPrim << " ms  peso=" << pesoTotal(referencia)
+                 << (pesoTotal(mst) == pesoTotal(referencia) ? "" : "  ERROR");
+        }
+        cout << endl;
+    }
+}
+
+// Actualizaciones del MST dinámico contra recalcular Prim denso después de cada una
+// Parámetros: N (nodos), U (actualizaciones)
+void benchMSTDinamico(int N, int U)
+{
+    mt19937 gen(11);
+    uniform_int_distribution<int> nodo(0, N - 1), peso(1, 1000000);
+    vector<int> matriz((size_t)N * N, 0);
+    for (int i = 0; i < N; ++i)
+        for (int j = i + 1; j < N; ++j)
+            matriz[(size_t)i * N + j] = matriz[(size_t)j * N + i] = peso(gen);
+
+    MSTDinamico dinamico(N, matriz);
+    vector<Arista> salieron, entraron;
+    double msDinamico = 0, msPrim = 0;
+    bool correcto = true;
+    for (int u = 0; u < U; ++u)
+    {
+        // La mitad de las actualizaciones tocan aristas del árbol para ejercitar la búsqueda de reemplazo
+        int a = nodo(gen), b = nodo(gen), w = peso(gen);
+        if (u % 2 == 0)
+        {
+            vector<Arista> arbol = dinamico.aristas();
+            a = arbol[u % arbol.size()].nodoA;
+            b = arbol[u % arbol.size()].nodoB;
+        }
+        msDinamico += medirMs([&]
+                              { dinamico.actualizar(a, b, w, salieron, entraron); });
+        if (a != b)
+            matriz[(size_t)a * N + b] = matriz[(size_t)b * N + a] = w;
+        vector<Arista> referencia;
+        msPrim += medirMs([&]
+                          { referencia = primDenso(N, matriz); });
+        correcto &= pesoTotal(referencia) == dinamico.pesoTotal;
+    }
+    cout << "N=" << N << " U=" << U << "  dinamico " << msDinamico / U << " ms/act  prim " << msPrim / U
+         << " ms/act  cambios=" << entraron.size() << (correcto ? "" : "  ERROR") << endl;
+}
+
+// Carga en dist las distancias euclidianas redondeadas de N centrales aleatorias y reinicia la búsqueda
+void instanciaTSP(int n, unsigned semilla)
+{
+    vector<pair<int, int>> centrales = centralesAleatorias(n, 1000, semilla);
+    dist.assign(n, vector<int>(n));
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            dist[i][j] = pesoEuclidiano(centrales[i], centrales[j]);
+    inicializarTSP(n);
+}
+
+// Nodos expandidos y tiempo del branch and bound con cada cota inferior
+// Parámetros: N mínimo y máximo; se usan 3 instancias euclidianas por tamaño
+void benchCotas(int minN, int maxN)
+{
+    const char *nombres[] = {"simple", "unoarbol", "lagrange"};
+    for (int n = minN; n <= maxN; ++n)
+    {
+        for (unsigned semilla = 1; semilla <= 3; ++semilla)
+        {
+            cout << "N=" << n << " semilla=" << semilla;
+            for (int c = COTA_SIMPLE; c <= COTA_LAGRANGE; ++c)
+            {
+                instanciaTSP(n, semilla);
+                cotaTSP = (CotaTSP)c;
+                double ms = medirMs([]
+                                    { resolverTSP("bb"); });
+                cout << "  " << nombres[c] << ": " << nodosExpandidos << " nodos " << ms << " ms "
+                     << ms * 1e6 / nodosExpandidos << " ns/nodo costo=" << costoMinimo;
+            }
+            cout << endl;
+        }
+    }
+}
+
+// Escalamiento del branch and bound con robo de trabajo según el número de hilos
+// Parámetros: N, máximo de hilos
+void benchBranchAndBound(int n, int maxHilos)
+{
+    for (int hilos = 1; hilos <= maxHilos; hilos *= 2)
+    {
+        instanciaTSP(n, 5);
+        numHilos = hilos;
+        double ms = medirMs([]
+                            { resolverTSP("bb"); });
+        cout << "N=" << n << " hilos=" << hilos << "  " << ms << " ms  " << nodosExpandidos << " nodos  costo=" << costoMinimo << endl;
+    }
+}
+
+// Kernel especializado (bitset y matriz plana) contra el genérico, con la cota simple y un hilo
+// Parámetros: N mínimo y máximo; se usan 3 instancias euclidianas por tamaño
+void benchKernel(int minN, int maxN)
+{
+    numHilos = 1;
+    cotaTSP = COTA_SIMPLE;
+    for (int n = minN; n <= maxN; ++n)
+    {
+        for (unsigned semilla = 1; semilla <= 3; ++semilla)
+        {
+            cout << "N=" << n << " semilla=" << semilla;
+            int costos[2];
+            for (int fijo = 0; fijo <= 1; ++fijo)
+            {
+                instanciaTSP(n, semilla);
+                kernelFijo = fijo;
+                double ms = medirMs([]
+                                    { resolverTSP("bb"); });
+                costos[fijo] = costoMinimo;
+                cout << "  " << (fijo ? "fijo" : "generico") << ": " << nodosExpandidos << " nodos " << ms << " ms "
+                     << ms * 1e6 / nodosExpandidos << " ns/nodo";
+            }
+            cout << "  costo=" << costos[1] << (costos[0] == costos[1] ? "" : "  ERROR") << endl;
+        }
+    }
+}
+
+// Búsqueda en profundidad contra mejor primero (sin límite de memoria y con 16 KB), con la cota de Lagrange
+// Parámetros: N mínimo y máximo; se usan 3 instancias euclidianas por tamaño
+void benchBusqueda(int minN, int maxN)
+{
+    struct Variante
+    {
+        const char *nombre;
+        BusquedaTSP busqueda;
+        unsigned long long memoria;
+    } variantes[] = {{"profundidad", BUSQUEDA_PROFUNDIDAD, 1024ULL << 20},
+                     {"mejor", BUSQUEDA_MEJOR, 1024ULL << 20},
+                     {"mejor-16KB", BUSQUEDA_MEJOR, 16ULL << 10}};
+    cotaTSP = COTA_LAGRANGE;
+    for (int n = minN; n <= maxN; ++n)
+    {
+        for (unsigned semilla = 1; semilla <= 3; ++semilla)
+        {
+            cout << "N=" << n << " semilla=" << semilla;
+            int referencia = -1;
+            for (const Variante &v : variantes)
+            {
+                instanciaTSP(n, semilla);
+                busquedaTSP = v.busqueda;
+                memoriaMaximaTSP = v.memoria;
+                double ms = medirMs([]
+                                    { resolverTSP("bb"); });
+                if (referencia < 0)
+                    referencia = costoMinimo;
+                cout << "  " << v.nombre << ": " << nodosExpandidos << " nodos " << ms << " ms"
+                     << (costoMinimo == referencia ? "" : " ERROR");
+            }
+            cout << "  costo=" << referencia << endl;
+        }
+    }
+    busquedaTSP = BUSQUEDA_PROFUNDIDAD;
+    memoriaMaximaTSP = 1024ULL << 20;
+}
+
+// Branch and bound en profundidad con y sin tabla de transposición, con la cota simple y la de Lagrange
+// Parámetros: N mínimo y máximo; se usan 3 instancias euclidianas por tamaño
+void benchTransposicion(int minN, int maxN)
+{
+    const char *nombres[] = {"simple", "unoarbol", "lagrange"};
+    unsigned long long memoria = memoriaTablaTSP;
+    for (int n = minN; n <= maxN; ++n)
+    {
+        for (unsigned semilla = 1; semilla <= 3; ++semilla)
+        {
+            for (CotaTSP c : {COTA_SIMPLE, COTA_LAGRANGE})
+            {
+                cout << "N=" << n << " semilla=" << semilla << " " << nombres[c];
+                vector<int> referencia;
+                for (unsigned long long tabla : {0ULL, memoria})
+                {
+                    instanciaTSP(n, semilla);
+                    cotaTSP = c;
+                    memoriaTablaTSP = tabla;
+                    double ms = medirMs([]
+                                        { resolverTSP("bb"); });
+                    if (referencia.empty())
+                        referencia = caminoMin;
+                    cout << "  " << (tabla ? "con tabla" : "sin tabla") << ": " << nodosExpandidos << " nodos " << ms << " ms"
+                         << (caminoMin == referencia ? "" : " ERROR");
+                }
+                cout << "  costo=" << costoMinimo << endl;
+            }
+        }
+    }
+    memoriaTablaTSP = memoria;
+}
+
+// Orden de ramificación: por índice, por cercanía (exactos) y solo con candidatos (5 vecinos más cercanos
+// y vecinos de Delaunay), con la cota simple y un hilo; de los heurísticos se reporta el exceso sobre el óptimo
+// Parámetros: N mínimo y máximo; se usan 3 instancias euclidianas por tamaño
+void benchRamificacion(int minN, int maxN)
+{
+    struct Variante
+    {
+        const char *nombre;
+        RamificacionTSP ramificacion;
+        bool delaunay;
+    } variantes[] = {{"indice", RAMIFICACION_INDICE, false},
+                     {"cercanos", RAMIFICACION_CERCANOS, false},
+                     {"5-cercanos", RAMIFICACION_CANDIDATOS, false},
+                     {"delaunay", RAMIFICACION_CANDIDATOS, true}};
+    numHilos = 1;
+    cotaTSP = COTA_SIMPLE;
+    numCandidatos = 5;
+    for (int n = minN; n <= maxN; ++n)
+    {
+        for (unsigned semilla = 1; semilla <= 3; ++semilla)
+        {
+            cout << "N=" << n << " semilla=" << semilla;
+            int optimo = -1;
+            for (const Variante &v : variantes)
+            {
+                instanciaTSP(n, semilla);
+                candidatosExternos.clear();
+                if (v.delaunay)
+                {
+                    candidatosExternos.assign(n, {});
+                    for (const Arista &arista : aristasDelaunay(centralesAleatorias(n, 1000, semilla)))
+                    {
+                        candidatosExternos[arista.nodoA].push_back(arista.nodoB);
+                        candidatosExternos[arista.nodoB].push_back(arista.nodoA);
+                    }
+                }
+                ramificacionTSP = v.ramificacion;
+                double ms = medirMs([]
+                                    { resolverTSP("bb"); });
+                if (optimo < 0)
+                    optimo = costoMinimo;
+                cout << "  " << v.nombre << ": " << nodosExpandidos << " nodos " << ms << " ms";
+                if (v.ramificacion == RAMIFICACION_CANDIDATOS)
+                    cout << " +" << 100.0 * (costoMinimo - optimo) / optimo << "%";
+                else if (costoMinimo != optimo)
+                    cout << " ERROR";
+            }
+            cout << "  costo=" << optimo << endl;
+        }
+    }
+    ramificacionTSP = RAMIFICACION_INDICE;
+    candidatosExternos.clear();
+    numCandidatos = 8;
+}
+
+// Mínimo enmascarado de una fila: la lista ordenada de cotaInferior() y las versiones escalar, AVX2 y
+// AVX-512 de minimoEnmascarado, con la mitad de los nodos visitados al azar
+// Parámetros: N mínimo y máximo; se mide N = minN, 2 minN, ... con distancias uint16_t e int
+template <typename Costo>
+void benchMinimoCon(int n, const char *tipo)
+{
+    const int REPETICIONES = 4096, PALABRAS = (n + 63) / 64;
+    mt19937 gen(n);
+    uniform_int_distribution<int> peso(0, 60000);
+    vector<Costo> fila(PALABRAS * 64);
+    vector<int> orden(n);
+    for (Costo &d : fila)
+        d = peso(gen);
+    iota(orden.begin(), orden.end(), 0);
+    sort(orden.begin(), orden.end(), [&](int i, int j)
+         { return fila[i] < fila[j]; });
+
+    // Máscaras distintas por repetición para que no se pueda predecir el recorrido
+    vector<uint64_t> mascaras((size_t)REPETICIONES * PALABRAS);
+    for (int r = 0; r < REPETICIONES; r++)
+    {
+        uint64_t *visitado = &mascaras[(size_t)r * PALABRAS];
+        for (int i = 0; i < PALABRAS * 64; i++)
+            if (i >= n || (gen() & 1))
+                visitado[i >> 6] |= 1ULL << (i & 63);
+        visitado[0] &= ~1ULL; // al menos un nodo libre
+    }
+
+    long long referencia = 0;
+    double msOrdenada = medirMs([&]
+                                {
+        for (int r = 0; r < REPETICIONES; r++)
+        {
+            const uint64_t *visitado = &mascaras[(size_t)r * PALABRAS];
+            for (int i : orden)
+                if (!((visitado[i >> 6] >> (i & 63)) & 1))
+                {
+                    referencia += fila[i];
+                    break;
+                }
+        } });
+    cout << "N=" << n << " " << tipo << "  ordenada " << msOrdenada * 1e6 / REPETICIONES << " ns";
+
+    const char *nombres[] = {"escalar", "avx2", "avx512"};
+    string anterior = simdTSP;
+    for (const char *nombre : nombres)
+    {
+        simdTSP = nombre;
+        MinimoEnmascarado<Costo> minimo = elegirMinimoEnmascarado<Costo>();
+        long long suma = 0;
+        double ms = medirMs([&]
+                            {
+            for (int r = 0; r < REPETICIONES; r++)
+                suma += minimo(fila.data(), &mascaras[(size_t)r * PALABRAS], PALABRAS); });
+        cout << "  " << nombre << " " << ms * 1e6 / REPETICIONES << " ns" << (suma == referencia ? "" : " ERROR");
+    }
+    simdTSP = anterior;
+    cout << endl;
+}
+
+void benchMinimo(int minN, int maxN)
+{
+    for (int n = minN; n <= maxN; n *= 2)
+    {
+        benchMinimoCon<uint16_t>(n, "uint16");
+        benchMinimoCon<int>(n, "int   ");
+    }
+}
+
+// Christofides desde coordenadas: tiempo del MST (Delaunay) y del recorrido con emparejamiento voraz, y
+// exacto mientras los vértices impares no pasen de 2 * MAX_IMPARES_EXACTO. El costo se compara con el
+// peso del MST, que es una cota inferior del óptimo.
+// Parámetros: N máximo; se mide N = 1000, 2000, 5000, 10000, 20000, 50000, 100000, ...
+void benchChristofides(int maxN)
+{
+    for (int n = 1000, paso = 0; n <= maxN; n = (paso % 3 == 1 ? n * 5 / 2 : n * 2), paso++)
+    {
+        vector<pair<int, int>> centrales = centralesAleatorias(n, 1000000, 13);
+        vector<Arista> mst;
+        double msMST = medirMs([&]
+                               { mst = mstDelaunay(centrales); });
+        cout << "N=" << n << "  mst " << msMST << " ms";
+
+        int impares = 0;
+        vector<int> grado(n, 0);
+        for (const Arista &a : mst)
+            grado[a.nodoA]++, grado[a.nodoB]++;
+        for (int g : grado)
+            impares += g % 2;
+        cout << "  impares=" << impares;
+
+        string anterior = emparejamientoTSP;
+        for (const char *tipo : {"voraz", "exacto"})
+        {
+            if (string(tipo) == "exacto" && impares > 2 * MAX_IMPARES_EXACTO)
+                continue;
+            emparejamientoTSP = tipo;
+            long long costo;
+            vector<int> ruta;
+            double ms = medirMs([&]
+                                { ruta = recorridoChristofidesCoordenadas(centrales, mst, costo); });
+            vector<int> orden = ruta;
+            sort(orden.begin(), orden.end());
+            bool valido = orden.size() == (size_t)n && unique(orden.begin(), orden.end()) == orden.end();
+            cout << "  " << tipo << " " << ms << " ms costo/mst=" << (double)costo / pesoTotal(mst) << (valido ? "" : " ERROR");
+        }
+        emparejamientoTSP = anterior;
+        cout << endl;
+    }
+}
+
+// Modo aproximado: tiempo y costo de la heurística contra el vecino más cercano solo
+// Parámetros: N máximo; se mide N = 500, 1000, 2000, ...
+void benchHeuristica(int maxN)
+{
+    for (int n = 500; n <= maxN; n *= 2)
+    {
+        instanciaTSP(n, 3);
+        long long costo;
+        double ms = medirMs([&]
+                            { recorridoHeuristico(costo); });
+        auto d = [](int i, int j)
+        { return dist[i][j]; };
+        cout << "N=" << n << "  heuristica " << ms << " ms costo=" << costo
+             << "  vecino mas cercano costo=" << costoRecorrido(recorridoVecinoCercano(n, d), d) << endl;
+    }
+}
+
+// Rectángulo que encierra a las centrales, como en main()
+void rectangulo(const vector<pair<int, int>> &centrales, int &xmin, int &ymin, int &xmax, int &ymax)
+{
+    xmin = ymin = INT_MAX, xmax = ymax = INT_MIN;
+    for (const auto &central : centrales)
+    {
+        xmin = min(xmin, central.first), xmax = max(xmax, central.first);
+        ymin = min(ymin, central.second), ymax = max(ymax, central.second);
+    }
+}
+
+// Etiquetado de la malla de Voronoi (paso 10) por fuerza bruta contra la transformada de distancia, el árbol
+// k-d y el kernel SoA escalar, AVX2 y AVX-512 (este hasta N = 10000); cuenta las etiquetas distintas (deben ser cero). Con lado pequeño hay muchas centrales repetidas y empates.
+// Parámetros: N máximo y lado del cuadrado; se mide N = 10, 100, 1000, ... (fuerza bruta solo hasta 1000)
+void benchVoronoi(int maxN, int lado)
+{
+    for (int n = 10; n <= maxN; n *= 10)
+    {
+        for (int l : {lado / 100, lado})
+        {
+            vector<pair<int, int>> centrales = centralesAleatorias(n, l, n);
+            int xmin, ymin, xmax, ymax;
+            rectangulo(centrales, xmin, ymin, xmax, ymax);
+            vector<pair<int, int>> puntos;
+            vector<int> edt, fuerza;
+            double msEDT = medirMs([&]
+                                   { etiquetarVoronoiEDT(centrales, xmin, ymin, xmax, ymax, 10, [&](int x, int y, int central)
+                                                         { puntos.push_back({x, y}), edt.push_back(central); }); });
+            vector<int> kd;
+            double msConstruir = 0, msKD = 0;
+            msConstruir = medirMs([&]
+                                  {
+                ArbolKD arbol(centrales);
+                msKD = medirMs([&]
+                               { kd = arbol.masCercanas(puntos, numHilos); }); }) - msKD;
+            double msFuerza = n <= 1000 ? medirMs([&]
+                                                  {
+                for (const auto &punto : puntos)
+                    fuerza.push_back(centralMasCercana(punto.first, punto.second, centrales)); })
+                                        : 0;
+            size_t distintas = 0;
+            for (size_t i = 0; i < edt.size(); ++i)
+                distintas += kd[i] != edt[i] || (!fuerza.empty() && fuerza[i] != edt[i]);
+            cout << "N=" << n << " lado=" << l << " puntos=" << edt.size() << "  edt: " << msEDT << " ms  kd: "
+                 << msConstruir << " ms construir + " << msKD << " ms consultas";
+            if (!fuerza.empty())
+                cout << "  fuerza: " << msFuerza << " ms";
+            // Kernel SoA por columnas (la transformada entrega las etiquetas por filas)
+            for (const char *simd : {"escalar", "avx2", "avx512"})
+            {
+                if (n > 10000)
+                    break;
+                simdTSP = simd;
+                EtiquetadoSoA etiquetar = elegirEtiquetadoSoA();
+                CentralesSoA soa(centrales);
+                int columnas = (xmax - xmin) / 10 + 1, filas = (ymax - ymin) / 10 + 1;
+                vector<int> columna(filas);
+                double ms = medirMs([&]
+                                    {
+                    for (int a = 0; a < columnas; ++a)
+                    {
+                        etiquetar(soa, xmin + a * 10, ymin, 10, filas, columna.data());
+                        for (int b = 0; b < filas; ++b)
+                            distintas += columna[b] != edt[(size_t)b * columnas + a];
+                    } });
+                cout << "  " << simd << ": " << ms << " ms";
+            }
+            simdTSP = "auto";
+            cout << "  distintas=" << distintas << (distintas == 0 ? "" : "  ERROR") << endl;
+        }
+    }
+}
+
+// Celdas de Voronoi exactas por recorte de semiplanos: tiempo y suma de áreas (debe ser la del rectángulo)
+// Parámetros: N máximo; se mide N = 1000, 10000, ... en un cuadrado de lado 10^6
+void benchCeldas(int maxN)
+{
+    for (int n = 1000; n <= maxN; n *= 10)
+    {
+        vector<pair<int, int>> centrales = centralesAleatorias(n, 1000000, n);
+        int xmin, ymin, xmax, ymax;
+        rectangulo(centrales, xmin, ymin, xmax, ymax);
+        vector<vector<pair<double, double>>> celdas(n);
+        double ms = medirMs([&]
+                            {
+            ArbolKD arbol(centrales);
+            ejecutarConRobo(n, numHilos, [&](size_t c, int)
+                            { celdas[c] = celdaExacta(c, centrales, arbol, xmin, ymin, xmax, ymax); }); });
+        double area = 0;
+        size_t vertices = 0;
+        for (const auto &celda : celdas)
+        {
+            vertices += celda.size();
+            for (size_t i = 0; i < celda.size(); ++i)
+                area += celda[i].first * celda[(i + 1) % celda.size()].second - celda[i].second * celda[(i + 1) % celda.size()].first;
+        }
+        double rectangulo = (double)(xmax - xmin) * (ymax - ymin);
+        cout << "N=" << n << "  " << ms << " ms  " << (double)vertices / n << " vértices/celda  error de área="
+             << fabs(area / 2 - rectangulo) / rectangulo << endl;
+    }
+}
+
+// Versión recursiva anterior de ramerDouglasPeucker(), que copia las dos mitades en cada nivel; solo como referencia
+void ramerDouglasPeuckerRecursivo(const vector<pair<int, int>> &puntos, double epsilon, vector<pair<int, int>> &resultado)
+{
+    if (puntos.size() < 2)
+        return;
+    auto distancia = [](const pair<int, int> &punto, const pair<int, int> &inicio, const pair<int, int> &fin)
+    {
+        double a = (double)fin.second - inicio.second, b = (double)inicio.first - fin.first;
+        double c = a * inicio.first + b * inicio.second;
+        return abs(a * punto.first + b * punto.second - c) / sqrt(a * a + b * b);
+    };
+    size_t maxI = 0;
+    double maxDist = 0.0;
+    for (size_t i = 1; i < puntos.size() - 1; ++i)
+    {
+        double d = distancia(puntos[i], puntos.front(), puntos.back());
+        if (d > maxDist)
+            maxI = i, maxDist = d;
+    }
+    if (maxDist > epsilon)
+    {
+        vector<pair<int, int>> antes(puntos.begin(), puntos.begin() + maxI + 1), despues(puntos.begin() + maxI, puntos.end());
+        ramerDouglasPeuckerRecursivo(antes, epsilon, resultado);
+        resultado.pop_back();
+        ramerDouglasPeuckerRecursivo(despues, epsilon, resultado);
+    }
+    else
+    {
+        resultado.push_back(puntos.front());
+        resultado.push_back(puntos.back());
+    }
+}
+
+// Ramer-Douglas-Peucker sobre contornos cerrados de N puntos (un círculo de radio 10^6 con ruido de +-r): la
+// versión recursiva anterior contra la iterativa sobre rangos de índices (deben dar lo mismo) y la de polígono cerrado
+// Parámetros: N; se usan ruido 0, 10 y 1000 con epsilon 30
+void benchRDP(int n)
+{
+    for (int ruido : {0, 10, 1000})
+    {
+        mt19937 gen(ruido);
+        uniform_int_distribution<int> desvio(-ruido, ruido);
+        vector<pair<int, int>> contorno(n);
+        for (int i = 0; i < n; ++i)
+        {
+            double angulo = 2 * M_PI * i / n;
+            contorno[i] = {(int)lround(1e6 * cos(angulo)) + desvio(gen), (int)lround(1e6 * sin(angulo)) + desvio(gen)};
+        }
+        vector<pair<int, int>> recursivo, iterativo, cerrado;
+        double msRecursivo = medirMs([&]
+                                     { ramerDouglasPeuckerRecursivo(contorno, 30.0, recursivo); });
+        double msIterativo = medirMs([&]
+                                     { ramerDouglasPeucker(contorno, 30.0, iterativo); });
+        double msCerrado = medirMs([&]
+                                   { ramerDouglasPeuckerCerrado(contorno, 30.0, cerrado); });
+        cout << "N=" << n << " ruido=" << ruido << "  recursivo: " << msRecursivo << " ms  iterativo: " << msIterativo
+             << " ms  cerrado: " << msCerrado << " ms  vértices=" << iterativo.size() << "/" << cerrado.size()
+             << (recursivo == iterativo ? "" : "  ERROR") << endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    string nombre = argc > 1 ? argv[1] : "";
+    if (nombre == "filter-kruskal")
+    {
+        benchFilterKruskal(argc > 2 ? stoi(argv[2]) : 1000000, argc > 3 ? stoull(argv[3]) : 20000000,
+                           argc > 4 ? stoi(argv[4]) : numHilos);
+    }
+    else if (nombre == "boruvka")
+    {
+        benchBoruvka(argc > 2 ? stoi(argv[2]) : 1000000, argc > 3 ? stoull(argv[3]) : 20000000,
+                     argc > 4 ? stoi(argv[4]) : numHilos);
+    }
+    else if (nombre == "delaunay")
+    {
+        benchDelaunay(argc > 2 ? stoi(argv[2]) : 128000);
+    }
+    else if (nombre == "mst-dinamico")
+    {
+        benchMSTDinamico(argc > 2 ? stoi(argv[2]) : 2000, argc > 3 ? stoi(argv[3]) : 200);
+    }
+    else if (nombre == "cotas")
+    {
+        benchCotas(argc > 2 ? stoi(argv[2]) : 8, argc > 3 ? stoi(argv[3]) : 12);
+    }
+    else if (nombre == "bb-paralelo")
+    {
+        benchBranchAndBound(argc > 2 ? stoi(argv[2]) : 18, argc > 3 ? stoi(argv[3]) : numHilos);
+    }
+    else if (nombre == "kernel")
+    {
+        benchKernel(argc > 2 ? stoi(argv[2]) : 10, argc > 3 ? stoi(argv[3]) : 13);
+    }
+    else if (nombre == "busqueda")
+    {
+        benchBusqueda(argc > 2 ? stoi(argv[2]) : 14, argc > 3 ? stoi(argv[3]) : 22);
+    }
+    else if (nombre == "transposicion")
+    {
+        benchTransposicion(argc > 2 ? stoi(argv[2]) : 12, argc > 3 ? stoi(argv[3]) : 16);
+    }
+    else if (nombre == "ramificacion")
+    {
+        benchRamificacion(argc > 2 ? stoi(argv[2]) : 12, argc > 3 ? stoi(argv[3]) : 16);
+    }
+    else if (nombre == "voronoi")
+    {
+        benchVoronoi(argc > 2 ? stoi(argv[2]) : 100000, argc > 3 ? stoi(argv[3]) : 20000);
+    }
+    else if (nombre == "celdas")
+    {
+        benchCeldas(argc > 2 ? stoi(argv[2]) : 1000000);
+    }
+    else if (nombre == "rdp")
+    {
+        benchRDP(argc > 2 ? stoi(argv[2]) : 1000000);
+    }
+    else if (nombre == "minimo")
+    {
+        benchMinimo(argc > 2 ? stoi(argv[2]) : 16, argc > 3 ? stoi(argv[3]) : 512);
+    }
+    else if (nombre == "christofides")
+    {
+        benchChristofides(argc > 2 ? stoi(argv[2]) : 100000);
+    }
+    else if (nombre == "heuristica")
+    {
+        benchHeuristica(argc > 2 ? stoi(argv[2]) : 8000);
+    }
+    else
+    {
+        cout << "Benchmarks: filter-kruskal [N E hilos] | boruvka [N E hilos] | delaunay [N] | mst-dinamico [N U] | cotas [minN maxN]"
+             << " | bb-paralelo [N hilos] | kernel [minN maxN] | minimo [minN maxN]"
+             << " | busqueda [minN maxN] | transposicion [minN maxN] | christofides [N]"
+             << " | heuristica [N] | ramificacion [minN maxN] | voronoi [N lado] | celdas [N] | rdp [N]" << endl;
+    }
+    return 0;
+}
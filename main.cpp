@@ -2,9 +2,128 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <cmath>
+#include <climits>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <iomanip>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Triangulación de Delaunay (namespace delaunay) para el árbol de expansión mínima euclidiano
+#define DELAUNAY_SIN_MAIN
+#include "voronoi.cpp"
 
 using namespace std;
 
+/*
+Paralelismo --------------------------------
+*/
+int numHilos = max(1u, thread::hardware_concurrency()); // Hilos a usar en los motores paralelos (--hilos=)
+
+// Divide el rango [0, n) en bloques contiguos y ejecuta f(inicio, fin, hilo) sobre cada bloque en su propio hilo
+// Con un solo hilo (o pocos elementos) se ejecuta en el hilo actual sin crear hilos nuevos
+template <typename F>
+void paraleloEnBloques(size_t n, int hilos, F f)
+{
+    hilos = (int)min<size_t>(max(1, hilos), max<size_t>(1, n));
+    if (hilos == 1)
+    {
+        f((size_t)0, n, 0);
+        return;
+    }
+    vector<thread> trabajadores;
+    size_t bloque = (n + hilos - 1) / hilos;
+    for (int h = 0; h < hilos; ++h)
+    {
+        size_t inicio = min(n, h * bloque);
+        size_t fin = min(n, inicio + bloque);
+        trabajadores.emplace_back(f, inicio, fin, h);
+    }
+    for (thread &t : trabajadores)
+    {
+        t.join();
+    }
+}
+
+// Ejecuta las tareas 0..n-1 con un pool de hilos con robo de trabajo: cada hilo empieza con un bloque
+// contiguo de tareas en su propia cola, las toma del frente y, cuando se le acaban, roba del final de
+// la cola de otro hilo. f(tarea, hilo) no debe agregar tareas nuevas.
+template <typename F>
+void ejecutarConRobo(size_t n, int hilos, F f)
+{
+    struct Cola
+    {
+        mutex candado;
+        deque<size_t> tareas;
+    };
+    hilos = (int)min<size_t>(max(1, hilos), max<size_t>(1, n));
+    vector<Cola> colas(hilos);
+    for (int h = 0; h < hilos; ++h)
+    {
+        for (size_t t = n * h / hilos; t < n * (h + 1) / hilos; ++t)
+        {
+            colas[h].tareas.push_back(t);
+        }
+    }
+
+    auto trabajador = [&](int h)
+    {
+        while (true)
+        {
+            bool encontrada = false;
+            size_t tarea = 0;
+            for (int v = 0; v < hilos && !encontrada; ++v)
+            {
+                Cola &cola = colas[(h + v) % hilos];
+                lock_guard<mutex> guardia(cola.candado);
+                if (!cola.tareas.empty())
+                {
+                    encontrada = true;
+                    if (v == 0)
+                    {
+                        tarea = cola.tareas.front();
+                        cola.tareas.pop_front();
+                    }
+                    else
+                    {
+                        tarea = cola.tareas.back();
+                        cola.tareas.pop_back();
+                    }
+                }
+            }
+            if (!encontrada)
+            {
+                return; // Nadie agrega tareas, así que todas las colas vacías significa que se terminó
+            }
+            f(tarea, h);
+        }
+    };
+
+    vector<thread> trabajadores;
+    for (int h = 1; h < hilos; ++h)
+    {
+        trabajadores.emplace_back(trabajador, h);
+    }
+    trabajador(0);
+    for (thread &t : trabajadores)
+    {
+        t.join();
+    }
+}
+
 /*
 ***************************
 ***************************
@@ -16,369 +135,4213 @@ const int INF = 1e9; // Representa un valor infinito
 
 vector<vector<int>> dist; // Matriz de distancias
 int N;                    // Número de nodos
-vector<bool> visitado;    // Vector para registrar los nodos que ya hemos visitado
-vector<int> camino;       // Vector para guardar el camino actual
 vector<int> caminoMin;    // Vector para guardar el camino mínimo
 int costoMinimo = INF;    // Variable para guardar el costo mínimo
 
+atomic<long long> nodosExpandidos(0); // Nodos del árbol de búsqueda que visitó TSP()
+
+// Estado de una búsqueda: cada tarea del branch and bound tiene el suyo, así que varias corren en paralelo.
+// La búsqueda es una plantilla sobre el estado; este es el genérico, para cualquier N, y lee dist.
+struct EstadoTSP
+{
+    vector<bool> visitado; // Vector para registrar los nodos que ya hemos visitado
+    vector<int> camino;    // Vector para guardar el camino actual
+    uint32_t tarea = 0;    // Índice de la tarea; las tareas siguen el orden lexicográfico de sus prefijos
+    long long nodos = 0;   // Nodos expandidos por esta búsqueda
+
+    static const bool CON_TABLA = false; // No usa la tabla de transposición (ver dominado())
+
+    EstadoTSP(int n) : visitado(n, false), camino(n) {}
+
+    int d(int i, int j) const { return dist[i][j]; }
+    bool libre(int i) const { return !visitado[i]; }
+    void marcar(int i) { visitado[i] = true; }
+    void desmarcar(int i) { visitado[i] = false; }
+
+    // Llama f(i) con cada nodo no visitado en orden ascendente
+    template <typename F>
+    void paraCadaLibre(F f) const
+    {
+        for (int i = 0; i < N; i++)
+        {
+            if (!visitado[i])
+            {
+                f(i);
+            }
+        }
+    }
+};
+
+// Mínimo de una fila de distancias sobre los nodos no visitados: min fila[i] con el bit i de visitado en 0.
+// La fila tiene palabras * 64 columnas (las de relleno van marcadas) y debe haber al menos un nodo libre.
+// Hay una versión escalar y dos vectoriales (AVX2 y AVX-512); elegirMinimoEnmascarado() escoge la mejor
+// que soporte el procesador al arrancar.
+template <typename Costo>
+using MinimoEnmascarado = int (*)(const Costo *fila, const uint64_t *visitado, int palabras);
+
+string simdTSP = "auto"; // --simd=auto|avx512|avx2|escalar (también para el etiquetado de Voronoi)
+
+template <typename Costo>
+int minimoEnmascaradoEscalar(const Costo *fila, const uint64_t *visitado, int palabras)
+{
+    int minimo = INF;
+    for (int w = 0; w < palabras; w++)
+    {
+        uint64_t libres = ~visitado[w];
+        while (libres)
+        {
+            minimo = min(minimo, (int)fila[w * 64 + __builtin_ctzll(libres)]);
+            libres &= libres - 1;
+        }
+    }
+    return minimo;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// AVX2 no tiene registros de máscara: cada grupo de bits de visitado se copia a todos los carriles, se aísla
+// el bit de cada carril y los carriles visitados se llenan con el máximo antes de tomar el mínimo
+__attribute__((target("avx2"))) int minimoEnmascaradoAVX2(const uint16_t *fila, const uint64_t *visitado, int palabras)
+{
+    const __m256i bits = _mm256_setr_epi16(1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7, 1 << 8,
+                                           1 << 9, 1 << 10, 1 << 11, 1 << 12, 1 << 13, 1 << 14, (short)(1 << 15));
+    __m256i minimo = _mm256_set1_epi16(-1);
+    for (int w = 0; w < palabras; w++)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            __m256i marca = _mm256_and_si256(_mm256_set1_epi16((short)(visitado[w] >> (16 * k))), bits);
+            __m256i ocupado = _mm256_cmpeq_epi16(marca, bits);
+            __m256i d = _mm256_loadu_si256((const __m256i *)(fila + w * 64 + 16 * k));
+            minimo = _mm256_min_epu16(minimo, _mm256_or_si256(d, ocupado));
+        }
+    }
+    __m128i mitad = _mm_min_epu16(_mm256_castsi256_si128(minimo), _mm256_extracti128_si256(minimo, 1));
+    return _mm_cvtsi128_si32(_mm_minpos_epu16(mitad)) & 0xFFFF;
+}
+
+__attribute__((target("avx2"))) int minimoEnmascaradoAVX2(const int *fila, const uint64_t *visitado, int palabras)
+{
+    const __m256i bits = _mm256_setr_epi32(1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7);
+    const __m256i maximo = _mm256_set1_epi32(INT_MAX);
+    __m256i minimo = maximo;
+    for (int w = 0; w < palabras; w++)
+    {
+        for (int k = 0; k < 8; k++)
+        {
+            __m256i marca = _mm256_and_si256(_mm256_set1_epi32((int)(visitado[w] >> (8 * k))), bits);
+            __m256i ocupado = _mm256_cmpeq_epi32(marca, bits);
+            __m256i d = _mm256_loadu_si256((const __m256i *)(fila + w * 64 + 8 * k));
+            minimo = _mm256_min_epi32(minimo, _mm256_blendv_epi8(d, maximo, ocupado));
+        }
+    }
+    __m128i m = _mm_min_epi32(_mm256_castsi256_si128(minimo), _mm256_extracti128_si256(minimo, 1));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(m);
+}
+
+// Mitades de 256 bits de un registro de 512. Se usa la extracción con máscara en ceros porque
+// _mm512_extracti64x4_epi64 y _mm512_castsi512_si256 (y _mm512_reduce_min_epi32, que las usa) parten de un
+// registro indefinido y g++ 12 avisa -Wuninitialized con -Wall
+__attribute__((target("avx512f"))) inline __m256i mitadBaja(__m512i v)
+{
+    return _mm512_maskz_extracti64x4_epi64(0xFF, v, 0);
+}
+
+__attribute__((target("avx512f"))) inline __m256i mitadAlta(__m512i v)
+{
+    return _mm512_maskz_extracti64x4_epi64(0xFF, v, 1);
+}
+
+// AVX-512 usa los bits libres directamente como máscara del mínimo
+__attribute__((target("avx512f,avx512bw"))) int minimoEnmascaradoAVX512(const uint16_t *fila, const uint64_t *visitado, int palabras)
+{
+    __m512i minimo = _mm512_set1_epi16(-1);
+    for (int w = 0; w < palabras; w++)
+    {
+        uint64_t libres = ~visitado[w];
+        minimo = _mm512_mask_min_epu16(minimo, (__mmask32)libres, minimo, _mm512_loadu_si512(fila + w * 64));
+        minimo = _mm512_mask_min_epu16(minimo, (__mmask32)(libres >> 32), minimo, _mm512_loadu_si512(fila + w * 64 + 32));
+    }
+    __m256i mitad = _mm256_min_epu16(mitadBaja(minimo), mitadAlta(minimo));
+    __m128i cuarto = _mm_min_epu16(_mm256_castsi256_si128(mitad), _mm256_extracti128_si256(mitad, 1));
+    return _mm_cvtsi128_si32(_mm_minpos_epu16(cuarto)) & 0xFFFF;
+}
+
+__attribute__((target("avx512f"))) int minimoEnmascaradoAVX512(const int *fila, const uint64_t *visitado, int palabras)
+{
+    __m512i minimo = _mm512_set1_epi32(INT_MAX);
+    for (int w = 0; w < palabras; w++)
+    {
+        uint64_t libres = ~visitado[w];
+        for (int k = 0; k < 4; k++)
+        {
+            minimo = _mm512_mask_min_epi32(minimo, (__mmask16)(libres >> (16 * k)), minimo,
+                                           _mm512_loadu_si512(fila + w * 64 + 16 * k));
+        }
+    }
+    __m256i mitad = _mm256_min_epi32(mitadBaja(minimo), mitadAlta(minimo));
+    __m128i m = _mm_min_epi32(_mm256_castsi256_si128(mitad), _mm256_extracti128_si256(mitad, 1));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(m);
+}
+#endif
+
 /**********
-Objetivo: Función para calcular la cota inferior
-Entradas: El camino que se ha recorrido hasta ahorita y la posicion
-Salidas: La suma de las distancias visitadas hasta ahora mas la distancia del nodo actual al nodo mas cercano
-Complejidad: O(n) donde n es el numero de nodos
+Objetivo: Elegir la versión de minimoEnmascarado según el procesador y --simd=
+Entradas: Nada (usa simdTSP)
+Salidas: La función más rápida disponible para filas de tipo Costo
+Complejidad: O(1)
+***********/
+template <typename Costo>
+MinimoEnmascarado<Costo> elegirMinimoEnmascarado()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    bool avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx512 && (simdTSP == "auto" || simdTSP == "avx512"))
+        return minimoEnmascaradoAVX512;
+    if (avx2 && simdTSP != "escalar")
+        return minimoEnmascaradoAVX2;
+#endif
+    return minimoEnmascaradoEscalar<Costo>;
+}
+
+// Estado especializado en tiempo de compilación para N <= MAXN: los visitados son un bitset de palabras de
+// 64 bits (los libres se recorren con ctz), el camino es un arreglo fijo y las distancias se leen de una
+// matriz plana con renglones de MAXN columnas y celdas de tipo Costo (uint16_t si caben, así la matriz de
+// 256 x 256 ocupa 128 KB). Los bits de los nodos >= N empiezan marcados para no revisarlos nunca.
+template <int MAXN, typename Costo>
+struct EstadoFijo
+{
+    static const int PALABRAS = (MAXN + 63) / 64;
+    static const bool CON_TABLA = PALABRAS == 1; // Los visitados caben en una palabra, que es la llave exacta
+    static inline vector<Costo> matriz;  // matriz[i * MAXN + j] = dist[i][j]; la llena branchAndBoundFijo()
+    static inline vector<Costo> matrizT; // matrizT[j * MAXN + i] = dist[i][j], para mínimos por columna
+    static inline MinimoEnmascarado<Costo> minimo = minimoEnmascaradoEscalar<Costo>;
+
+    uint64_t visitado[PALABRAS] = {};
+    int camino[MAXN];
+    uint32_t tarea = 0;
+    long long nodos = 0;
+
+    EstadoFijo(int n)
+    {
+        for (int i = n; i < PALABRAS * 64; i++)
+        {
+            marcar(i);
+        }
+    }
+
+    int d(int i, int j) const { return matriz[i * MAXN + j]; }
+    bool libre(int i) const { return !((visitado[i >> 6] >> (i & 63)) & 1); }
+    void marcar(int i) { visitado[i >> 6] |= 1ULL << (i & 63); }
+    void desmarcar(int i) { visitado[i >> 6] &= ~(1ULL << (i & 63)); }
+
+    // min d(x, i) y min d(i, x) sobre los i no visitados
+    int minimoSalida(int x) const { return minimo(&matriz[x * MAXN], visitado, PALABRAS); }
+    int minimoEntrada(int x) const { return minimo(&matrizT[x * MAXN], visitado, PALABRAS); }
+
+    // Llama f(i) con cada nodo no visitado en orden ascendente. f puede marcar y desmarcar nodos mientras
+    // los deje como estaban: los libres de cada palabra se toman antes de recorrerla.
+    template <typename F>
+    void paraCadaLibre(F f) const
+    {
+        for (int w = 0; w < PALABRAS; w++)
+        {
+            uint64_t libres = ~visitado[w];
+            while (libres)
+            {
+                int i = w * 64 + __builtin_ctzll(libres);
+                libres &= libres - 1;
+                f(i);
+            }
+        }
+    }
+};
+
+// Mejor recorrido conocido, compartido entre hilos: (costo << 32) | tarea que lo encontró.
+// Comparar la llave completa poda igual que comparar el costo, y en los empates gana la tarea con el
+// prefijo menor, así que el camino final es el mismo (el primero en orden lexicográfico) sin importar
+// cómo se repartan las tareas entre los hilos.
+atomic<uint64_t> incumbente;
+mutex candadoIncumbente; // Protege caminoMin al mejorar el incumbente
+
+inline uint64_t llaveIncumbente(int costo, uint32_t tarea)
+{
+    return ((uint64_t)(uint32_t)costo << 32) | tarea;
+}
+
+// Modo anytime (--tiempo-ms=): la respuesta debe estar lista antes de fechaLimite. El reloj arranca al
+// empezar a resolver el TSP (iniciarFechaLimite()), así que no cuenta la lectura de la entrada ni el MST.
+// Cada etapa revisa el reloj y se detiene a tiempo; los incumbentes que mejoran se reportan en la salida
+// de error.
+bool conFechaLimite = false;
+long long presupuestoMs = 0; // Valor de --tiempo-ms
+chrono::steady_clock::time_point inicioTSP, fechaLimite;
+atomic<bool> busquedaInterrumpida(false); // La búsqueda exacta se cortó por tiempo
+long long cotaRaiz = 0;                   // Mejor cota inferior conocida en la raíz (dos mínimos o 1-árbol)
+chrono::steady_clock::duration pasoCuadratico{}; // Lo que tardó una pasada O(N^2) por dist (el vecino más cercano)
+
+// Arranca el reloj del modo anytime; se reserva el 10% del presupuesto para terminar la etapa en curso e imprimir
+void iniciarFechaLimite()
+{
+    inicioTSP = chrono::steady_clock::now();
+    fechaLimite = inicioTSP + chrono::microseconds(presupuestoMs * 900);
+}
+
+// Verdadero si falta menos de 'margen' para la fecha límite (o ya pasó)
+inline bool quedaMenosDe(chrono::steady_clock::duration margen)
+{
+    return conFechaLimite && chrono::steady_clock::now() + margen >= fechaLimite;
+}
+
+inline bool tiempoAgotado()
+{
+    return quedaMenosDe(chrono::steady_clock::duration::zero());
+}
+
+// Reporta en la salida de error un incumbente nuevo y el tiempo desde que empezó el TSP
+void reportarIncumbente(long long costo)
+{
+    if (conFechaLimite)
+    {
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicioTSP).count();
+        cerr << "incumbente " << costo << " a los " << (long long)ms << " ms" << endl;
+    }
+}
+
+// Cota inferior que usa el branch and bound (--cota=simple|unoarbol|lagrange)
+enum CotaTSP
+{
+    COTA_SIMPLE,    // cotaInferior(): dos mínimos de vecino más cercano
+    COTA_UNO_ARBOL, // cotaUnoArbol() sin penalizaciones
+    COTA_LAGRANGE   // cotaUnoArbol() con penalizaciones de Held-Karp calculadas en la raíz
+};
+CotaTSP cotaTSP = COTA_LAGRANGE;
+
+// Orden en que el branch and bound expande los nodos (--busqueda=profundidad|mejor)
+enum BusquedaTSP
+{
+    BUSQUEDA_PROFUNDIDAD, // TSP() recursiva, en orden de índice
+    BUSQUEDA_MEJOR        // mejorPrimero(): el nodo abierto de menor cota primero
+};
+BusquedaTSP busquedaTSP = BUSQUEDA_PROFUNDIDAD;
+
+// Memoria permitida para la tabla de Held-Karp y para la cola de la búsqueda mejor primero (--memoria-mb=)
+unsigned long long memoriaMaximaTSP = 1024ULL << 20;
+
+template <typename Estado>
+int cotaUnoArbol(const Estado &estado, int pos, int costo); // Definida después de kruskal()
+void calcularPenalizaciones(int iteraciones);               // Definida después de kruskal()
+vector<int> recorridoHeuristico(long long &costo);          // Definida después de primDenso()
+vector<int> recorridoChristofides(long long &costo);        // Definida después de recorridoHeuristico()
+
+/**********
+Objetivo: Reiniciar el estado de la búsqueda para un problema de n nodos
+Entradas: El número de nodos (dist ya debe tener n x n)
+Salidas: Nada
+Complejidad: O(n)
 ***********/
-int cotaInferior(vector<int> &camino, int pos)
+void inicializarTSP(int n)
 {
-    int suma = 0;
+    N = n;
+    caminoMin = vector<int>(N); // Inicializa el vector del camino mínimo
+    costoMinimo = INF;
+    incumbente = llaveIncumbente(INF, UINT32_MAX);
+    nodosExpandidos = 0;
+    busquedaInterrumpida = false;
+    cotaRaiz = 0;
+    pasoCuadratico = chrono::steady_clock::duration::zero();
+}
+
+vector<int> ordenSalida;  // ordenSalida[x * N + k]: k-ésimo nodo con dist[x][i] menor
+vector<int> ordenEntrada; // ordenEntrada[x * N + k]: k-ésimo nodo con dist[i][x] menor
+
+// Orden de ramificación del branch and bound (--ramificacion=indice|cercanos|candidatos)
+enum RamificacionTSP
+{
+    RAMIFICACION_INDICE,    // Todos los no visitados por índice: el óptimo es el primero en orden lexicográfico
+    RAMIFICACION_CERCANOS,  // Todos los no visitados, del más cercano al más lejano (exacto)
+    RAMIFICACION_CANDIDATOS // Solo los no visitados de la lista de candidatos (heurístico)
+};
+RamificacionTSP ramificacionTSP = RAMIFICACION_INDICE;
+
+int numCandidatos = 8;                  // Tamaño de las listas de k vecinos más cercanos (--candidatos=k)
+vector<vector<int>> candidatosExternos; // Si no está vacía, candidatos de cada nodo (los vecinos de Delaunay)
+vector<int> inicioCandidatos;           // Candidatos de x: listaCandidatos[inicioCandidatos[x] .. inicioCandidatos[x + 1])
+vector<int> listaCandidatos;
+
+/**********
+Objetivo: Precalcular las listas de vecinos ordenados de cada nodo
+Entradas: Nada (usa dist, N, numCandidatos y candidatosExternos)
+Salidas: Verdadero si terminó; llena ordenSalida, ordenEntrada y las listas de candidatos: los numCandidatos
+         primeros de ordenSalida o, si se dieron, los candidatosExternos, en los dos casos por distancia
+         ascendente. En modo anytime regresa falso si se agota el tiempo antes de ordenar todas las filas.
+Complejidad: O(n^2 log n) donde n es el numero de nodos; se hace una sola vez antes de la búsqueda
+***********/
+bool prepararVecinos()
+{
+    // Llenar las dos matrices de orden cuesta como un par de pasadas por dist
+    if (quedaMenosDe(2 * pasoCuadratico))
+    {
+        return false;
+    }
+    ordenSalida.resize((size_t)N * N);
+    ordenEntrada.resize((size_t)N * N);
+    for (int x = 0; x < N; x++)
+    {
+        if (tiempoAgotado())
+        {
+            return false;
+        }
+        int *salida = &ordenSalida[(size_t)x * N], *entrada = &ordenEntrada[(size_t)x * N];
+        iota(salida, salida + N, 0);
+        iota(entrada, entrada + N, 0);
+        stable_sort(salida, salida + N, [x](int i, int j)
+                    { return dist[x][i] < dist[x][j]; });
+        stable_sort(entrada, entrada + N, [x](int i, int j)
+                    { return dist[i][x] < dist[j][x]; });
+    }
 
-    // Costo acumulado hasta ahora de los nodos ya visitados.
-    for (int i = 0; i < pos - 1; i++)
+    inicioCandidatos.assign(N + 1, 0);
+    listaCandidatos.clear();
+    for (int x = 0; x < N; x++)
     {
-        suma += dist[camino[i]][camino[i + 1]];
+        vector<int> propios;
+        if ((int)candidatosExternos.size() == N)
+        {
+            propios = candidatosExternos[x];
+            stable_sort(propios.begin(), propios.end(), [x](int i, int j)
+                        { return dist[x][i] < dist[x][j]; });
+        }
+        else
+        {
+            for (int k = 0; k < N && (int)propios.size() < numCandidatos; k++)
+                if (ordenSalida[(size_t)x * N + k] != x)
+                    propios.push_back(ordenSalida[(size_t)x * N + k]);
+        }
+        listaCandidatos.insert(listaCandidatos.end(), propios.begin(), propios.end());
+        inicioCandidatos[x + 1] = listaCandidatos.size();
+    }
+    return true;
+}
+
+/**********
+Objetivo: Recorrer los hijos de un nodo del árbol de búsqueda según ramificacionTSP
+Entradas: El estado, el nodo actual y f(i), que se llama con cada nodo i con el que se ramifica
+Salidas: Nada. Con candidatos, si ninguno está libre se usan todos los libres por distancia para que
+         el camino siempre se pueda completar.
+Complejidad: O(n) en el peor caso
+***********/
+template <typename Estado, typename F>
+void paraCadaRama(const Estado &estado, int actual, F f)
+{
+    if (ramificacionTSP == RAMIFICACION_INDICE)
+    {
+        estado.paraCadaLibre(f);
+        return;
+    }
+    if (ramificacionTSP == RAMIFICACION_CANDIDATOS)
+    {
+        bool alguno = false;
+        for (int k = inicioCandidatos[actual]; k < inicioCandidatos[actual + 1]; k++)
+        {
+            if (estado.libre(listaCandidatos[k]))
+            {
+                alguno = true;
+                f(listaCandidatos[k]);
+            }
+        }
+        if (alguno)
+        {
+            return;
+        }
+    }
+    const int *orden = &ordenSalida[(size_t)actual * N];
+    for (int k = 0; k < N; k++)
+    {
+        if (estado.libre(orden[k]))
+        {
+            f(orden[k]);
+        }
     }
+}
+
+/**********
+Objetivo: Función para calcular la cota inferior
+Entradas: El estado de la búsqueda, la posicion y el costo acumulado del camino
+Salidas: El costo del camino hasta ahora mas la distancia del nodo actual al nodo no visitado mas cercano
+         y la del no visitado mas cercano al nodo inicial
+Complejidad: O(1) amortizado: el costo del camino llega ya calculado y los minimos son la primera entrada
+             no visitada de las listas ordenadas (en el peor caso se saltan los pos nodos ya visitados)
+***********/
+template <typename Estado>
+int cotaInferior(const Estado &estado, int pos, int costo)
+{
+    int suma = costo;
 
     // Se calcula la suma para la cota inferior y asi podar el arbol
-    // se calcula un minimo al buscar el nodo mas cercano al nodo actual. esto sirve como estimacion para saber cuanto seria el costo minimo
-    // al saber el minimo, ya puedes saber un costo estimado del camino que te falta por recorrer
-    int minDist = INF;
-    for (int i = 0; i < N; i++)
+    // el nodo mas cercano al nodo actual sirve como estimacion del costo minimo de seguir el camino
+    int actual = estado.camino[pos - 1];
+    const int *salida = &ordenSalida[(size_t)actual * N];
+    for (int k = 0; k < N; k++)
     {
-        if (!visitado[i])
+        if (estado.libre(salida[k]))
         {
-            minDist = min(minDist, dist[camino[pos - 1]][i]);
+            suma += estado.d(actual, salida[k]);
+            break;
         }
     }
-    suma += minDist;
 
-    // Encontramos el nodo más cercano al nodo inicial
-    // esto sirve porque siempre se va a acabar en el nodo inicial. Entonces se calcula cuanto al menos te va a costar llegar al nodo inicial.
-    // ese costo minimo es el que se obtiene en este for.
-    minDist = INF;
-    for (int i = 0; i < N; i++)
+    // siempre se va a acabar en el nodo inicial, asi que al menos cuesta llegar a el desde el no visitado mas cercano
+    int inicio = estado.camino[0];
+    const int *entrada = &ordenEntrada[(size_t)inicio * N];
+    for (int k = 0; k < N; k++)
     {
-        if (!visitado[i])
+        if (estado.libre(entrada[k]))
         {
-            minDist = min(minDist, dist[i][camino[0]]);
+            suma += estado.d(entrada[k], inicio);
+            break;
         }
     }
-    suma += minDist;
 
     // se regresa el costo minimo estimado
     return suma;
 }
 
+/**********
+Objetivo: La misma cota inferior para el estado especializado
+Entradas: El estado de la búsqueda, la posicion y el costo acumulado del camino
+Salidas: El costo del camino más los dos mínimos, que salen de un recorrido vectorizado de la fila del
+         nodo actual y de la columna del inicial en vez de las listas ordenadas
+Complejidad: O(MAXN / w) donde w es el número de distancias por registro (16 o 32 con uint16_t)
+***********/
+template <int MAXN, typename Costo>
+int cotaInferior(const EstadoFijo<MAXN, Costo> &estado, int pos, int costo)
+{
+    return costo + estado.minimoSalida(estado.camino[pos - 1]) + estado.minimoEntrada(estado.camino[0]);
+}
+
+/*
+Tabla de transposición --------------------------------
+*/
+// Mejor costo de prefijo visto para cada (visitados, nodo actual), compartida entre hilos sin candados.
+// Una casilla son dos palabras: datos = costo (32 bits) | tarea (24) | nodo actual (8) y llave =
+// visitados ^ datos. Si dos hilos escriben la misma casilla a la vez y se lee una mezcla, llave ^ datos
+// ya no coincide con los visitados y solo se pierde una poda. Las casillas van en cubetas de dos: la
+// primera se queda con el camino con menos visitados (el que poda el subárbol más grande) y la segunda
+// guarda siempre el más reciente. Si todas se reemplazaran siempre, los millones de caminos profundos
+// borrarían los cortos antes de que la búsqueda vuelva a pasar por ellos.
+// La casilla no tiene constructor propio para poder pedir la tabla ya en ceros con calloc().
+struct CasillaTransposicion
+{
+    atomic<uint64_t> llave, datos;
+};
+static_assert(is_trivially_default_constructible<CasillaTransposicion>::value, "la tabla se crea con calloc()");
+
+struct LiberarTabla
+{
+    void operator()(CasillaTransposicion *tabla) const { free(tabla); }
+};
+unique_ptr<CasillaTransposicion[], LiberarTabla> tablaTransposicion;
+size_t casillasTabla = 0;
+bool tablaActiva = false;
+unsigned long long memoriaTablaTSP = 64ULL << 20; // Memoria máxima de la tabla (--tabla-mb=, 0 la apaga)
+
+/**********
+Objetivo: Vaciar la tabla de transposición para un problema de N nodos
+Entradas: Nada (usa N y memoriaTablaTSP)
+Salidas: Nada, deja la tabla activa si cabe al menos una cubeta
+Complejidad: O(1) al prepararla. La tabla (la potencia de dos más cercana al doble de los 2^(N-1) * N
+             estados posibles, sin pasar de memoriaTablaTSP) se pide nueva con calloc(), que para bloques
+             grandes entrega páginas del sistema que se ponen en ceros al tocarlas por primera vez; así
+             una búsqueda corta solo paga las páginas que usa y no los 64 MB completos.
+***********/
+void prepararTabla()
+{
+    size_t casillas = 2;
+    while (casillas * 2 * sizeof(CasillaTransposicion) <= memoriaTablaTSP && casillas < ((size_t)N << min(N, 40)))
+    {
+        casillas *= 2;
+    }
+    tablaActiva = memoriaTablaTSP >= 2 * sizeof(CasillaTransposicion);
+    tablaTransposicion.reset();
+    casillasTabla = 0;
+    if (!tablaActiva)
+    {
+        return;
+    }
+    tablaTransposicion.reset((CasillaTransposicion *)calloc(casillas, sizeof(CasillaTransposicion)));
+    tablaActiva = tablaTransposicion != nullptr;
+    casillasTabla = tablaActiva ? casillas : 0;
+}
+
+/**********
+Objetivo: Saber si un camino parcial está dominado y, si no, registrarlo en la tabla
+Entradas: Los visitados (como palabra), el nodo actual, el costo del camino y la tarea que lo explora
+Salidas: true si la tabla tiene un camino con la misma llave y (costo, tarea) menor o igual. Los dos
+         caminos terminan igual, así que el dominado no puede dar un recorrido mejor; con la tarea en la
+         comparación el empate se lo queda el primero en orden lexicográfico, como en el incumbente
+         (las tareas arriba de 2^24 - 1 comparten valor y solo pierden ese desempate).
+Complejidad: O(1)
+***********/
+inline bool dominado(uint64_t visitados, int actual, int costo, uint32_t tarea)
+{
+    uint64_t datos = ((uint64_t)(uint32_t)costo << 32) | ((uint64_t)min(tarea, 0xFFFFFFu) << 8) | (uint64_t)actual;
+    uint64_t h = visitados ^ ((uint64_t)actual * 0x9E3779B97F4A7C15ULL);
+    h = (h ^ (h >> 31)) * 0xBF58476D1CE4E5B9ULL;
+    CasillaTransposicion *cubeta = &tablaTransposicion[(h ^ (h >> 29)) & (casillasTabla - 2)];
+
+    uint64_t guardados[2], llaves[2];
+    for (int k = 0; k < 2; k++)
+    {
+        guardados[k] = cubeta[k].datos.load(memory_order_relaxed);
+        llaves[k] = cubeta[k].llave.load(memory_order_relaxed) ^ guardados[k];
+        if (llaves[k] == visitados && (guardados[k] & 0xFF) == (uint64_t)actual)
+        {
+            if ((guardados[k] >> 8) <= (datos >> 8))
+            {
+                return true;
+            }
+            cubeta[k].datos.store(datos, memory_order_relaxed);
+            cubeta[k].llave.store(visitados ^ datos, memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // Llave nueva: va a la primera casilla si está vacía o tiene al menos tantos visitados, si no a la segunda
+    int k = llaves[0] == 0 || __builtin_popcountll(visitados) <= __builtin_popcountll(llaves[0]) ? 0 : 1;
+    cubeta[k].datos.store(datos, memory_order_relaxed);
+    cubeta[k].llave.store(visitados ^ datos, memory_order_relaxed);
+    return false;
+}
+
+// La cota inferior que pide --cota= para el estado en la posición pos
+template <typename Estado>
+inline int cotaElegida(const Estado &estado, int pos, int costo)
+{
+    return cotaTSP == COTA_SIMPLE ? cotaInferior(estado, pos, costo) : cotaUnoArbol(estado, pos, costo);
+}
+
+/**********
+Objetivo: Ofrecer como incumbente un recorrido completo
+Entradas: El estado con el recorrido completo en camino y su costo con el regreso al inicio
+Salidas: Nada, si su llave es menor que la del incumbente actualiza incumbente y caminoMin
+Complejidad: O(n) cuando mejora, O(1) si no
+***********/
+template <typename Estado>
+void registrarRecorrido(const Estado &estado, int costo)
+{
+    uint64_t llave = llaveIncumbente(costo, estado.tarea);
+    if (llave < incumbente.load(memory_order_relaxed))
+    { // si el costo actual es menor al minimo, se actualizan los valores
+        lock_guard<mutex> guardia(candadoIncumbente);
+        if (llave < incumbente.load(memory_order_relaxed))
+        {
+            if ((llave >> 32) < (incumbente.load(memory_order_relaxed) >> 32))
+            {
+                reportarIncumbente((long long)(llave >> 32));
+            }
+            incumbente.store(llave, memory_order_relaxed);
+            caminoMin.assign(&estado.camino[0], &estado.camino[0] + N);
+        }
+    }
+}
+
 /**********
 Objetivo: Función recursiva para calcular el camino mínimo usando B&B
-Entradas: La posicion actual
+Entradas: El estado de la búsqueda (EstadoTSP o EstadoFijo), la posicion actual y el costo acumulado del
+          camino hasta ella
 Salidas: Nada
 Complejidad: O(n!) donde n es el número de nodos
 ***********/
-void TSP(int pos)
+template <typename Estado>
+void TSP(Estado &estado, int pos, int costo)
 {
+    estado.nodos++;
+
+    // En modo anytime se abandona la búsqueda al llegar a la fecha límite
+    if (tiempoAgotado())
+    {
+        busquedaInterrumpida = true;
+        return;
+    }
+
     // Si hemos visitado todos los nodos, comprobamos si el camino actual tiene un costo menor que el mínimo actual
     if (pos == N)
     {
-        int costoActual = 0;
-        for (int i = 0; i < N; i++)
+        registrarRecorrido(estado, costo + estado.d(estado.camino[N - 1], estado.camino[0])); // se cierra el ciclo
+        return;
+    }
+
+    // Si otro camino con los mismos visitados y el mismo nodo actual costó menos, este no puede mejorarlo
+    if constexpr (Estado::CON_TABLA)
+    {
+        if (tablaActiva && dominado(estado.visitado[0], estado.camino[pos - 1], costo, estado.tarea))
         {
-            costoActual += dist[camino[i]][camino[(i + 1) % N]]; // se obtiene el costo actual
+            return;
         }
-        if (costoActual < costoMinimo)
-        { // si el costo actual es menor al minimo, se actualizan los valores
-            costoMinimo = costoActual;
-            caminoMin = camino;
-        }
-        return;
     }
 
     // Si el camino actual tiene un costo menor que el mínimo actual, seguimos explorando
-    if (cotaInferior(camino, pos) < costoMinimo)
+    int cota = cotaElegida(estado, pos, costo);
+    if (llaveIncumbente(cota, estado.tarea) < incumbente.load(memory_order_relaxed))
     {
+        int actual = estado.camino[pos - 1];
+        paraCadaRama(estado, actual, [&](int i)
+                     { // se recorren todos los posibles caminos
+            estado.camino[pos] = i;
+            estado.marcar(i);
 
-        for (int i = 0; i < N; i++)
-        { // se recorren todos los posibles caminos
-            if (!visitado[i])
+            TSP(estado, pos + 1, costo + estado.d(actual, i));
+
+            estado.desmarcar(i); }); // para que se vuelva a considerar en el siguiente camino
+    }
+}
+
+// Nodo abierto de la búsqueda mejor primero. El camino parcial no se copia: se guarda en una arena como
+// una lista enlazada hacia la raíz (cada nodo del árbol ocupa 8 bytes) y se reconstruye al expandirlo.
+struct NodoArena
+{
+    int padre; // Índice del nodo padre en la arena, -1 en la raíz
+    int nodo;  // Último nodo del camino parcial
+};
+
+struct NodoAbierto
+{
+    int cota, profundidad, costo, indice; // indice: posición del camino parcial en la arena
+
+    // Menor cota primero; en empate el más profundo, que está más cerca de cerrar un recorrido
+    bool operator<(const NodoAbierto &otro) const
+    {
+        return cota != otro.cota ? cota > otro.cota : profundidad < otro.profundidad;
+    }
+};
+
+/**********
+Objetivo: Cargar en el estado el camino parcial de un nodo de la arena
+Entradas: El estado (sin nodos marcados), la arena y el nodo abierto
+Salidas: Nada, deja el camino y los visitados del nodo en el estado
+Complejidad: O(profundidad)
+***********/
+template <typename Estado>
+void cargarCamino(Estado &estado, const vector<NodoArena> &arena, const NodoAbierto &abierto)
+{
+    for (int k = abierto.profundidad - 1, i = abierto.indice; k >= 0; k--, i = arena[i].padre)
+    {
+        estado.camino[k] = arena[i].nodo;
+        estado.marcar(arena[i].nodo);
+    }
+}
+
+/**********
+Objetivo: Branch and bound mejor primero con memoria acotada
+Entradas: El tipo de estado como parámetro de la plantilla (usa dist, N, numHilos y memoriaMaximaTSP)
+Salidas: Nada, actualiza caminoMin y costoMinimo
+Complejidad: O(n!) en el peor caso, como la búsqueda en profundidad, pero expande cada nodo a lo más una
+             vez y solo los que tienen cota menor al óptimo (más los empates). Cuando los hijos del
+             siguiente nodo ya no caben en la arena y la cola dentro de memoriaMaximaTSP (reservadas una
+             sola vez) deja de abrir nodos y termina cada nodo abierto con TSP() en
+             profundidad, en orden de cota, repartidos en el pool con robo de trabajo.
+***********/
+template <typename Estado>
+void mejorPrimero()
+{
+    // Cada nodo abierto ocupa una entrada de la arena, a lo más una de la cola (un montículo sobre un
+    // vector) y, si queda pendiente al final, una tarea de ejecutarConRobo(); con maxNodos de cada una no
+    // pasan juntas de memoriaMaximaTSP. Se reservan una sola vez: push_back nunca duplica la capacidad ni
+    // copia, y el sistema solo pone las páginas que se tocan.
+    const size_t maxNodos = memoriaMaximaTSP / (sizeof(NodoArena) + sizeof(NodoAbierto) + sizeof(size_t));
+    vector<NodoArena> arena;
+    vector<NodoAbierto> abiertos;
+    arena.reserve(maxNodos);
+    abiertos.reserve(maxNodos);
+    arena.push_back({-1, 0});
+    Estado estado(N);
+    estado.camino[0] = 0;
+    estado.marcar(0);
+    abiertos.push_back({cotaElegida(estado, 1, 0), 1, 0, 0});
+    estado.desmarcar(0);
+
+    auto costoIncumbente = []
+    {
+        return (int)(incumbente.load(memory_order_relaxed) >> 32);
+    };
+
+    // Todos los recorridos de esta fase usan la tarea 0; los nodos con cota igual al incumbente se
+    // expanden solo si el incumbente es el de la heurística (tarea UINT32_MAX), como en TSP()
+    // Un nodo solo se expande si caben todos sus hijos (a lo más N)
+    while (!abiertos.empty() && llaveIncumbente(abiertos.front().cota, 0) < incumbente.load(memory_order_relaxed) &&
+           arena.size() + N <= maxNodos)
+    {
+        if (tiempoAgotado())
+        {
+            busquedaInterrumpida = true;
+            break;
+        }
+        pop_heap(abiertos.begin(), abiertos.end());
+        NodoAbierto abierto = abiertos.back();
+        abiertos.pop_back();
+        cargarCamino(estado, arena, abierto);
+        int pos = abierto.profundidad, actual = estado.camino[pos - 1];
+
+        paraCadaRama(estado, actual, [&](int i)
+                     {
+            estado.nodos++;
+            estado.camino[pos] = i;
+            estado.marcar(i);
+            int costo = abierto.costo + estado.d(actual, i);
+            if (pos + 1 == N)
+            {
+                registrarRecorrido(estado, costo + estado.d(i, estado.camino[0]));
+            }
+            else
+            {
+                int cota = cotaElegida(estado, pos + 1, costo);
+                if (llaveIncumbente(cota, 0) < incumbente.load(memory_order_relaxed))
+                {
+                    abiertos.push_back({cota, pos + 1, costo, (int)arena.size()});
+                    push_heap(abiertos.begin(), abiertos.end());
+                    arena.push_back({abierto.indice, i});
+                }
+            }
+            estado.desmarcar(i); });
+
+        for (int k = 0; k < pos; k++)
+        {
+            estado.desmarcar(estado.camino[k]);
+        }
+    }
+    nodosExpandidos += estado.nodos;
+
+    // Sin memoria: los nodos abiertos que todavía pueden mejorar se terminan en profundidad. La tarea k + 1
+    // es el k-ésimo en orden de cota, así que los empates se resuelven igual con cualquier número de hilos.
+    // sort_heap() saca los nodos como pop_heap() uno por uno, así que al revés quedan en el mismo orden
+    // sin copiar la cola
+    sort_heap(abiertos.begin(), abiertos.end());
+    reverse(abiertos.begin(), abiertos.end());
+    size_t pendientes = 0;
+    while (pendientes < abiertos.size() && llaveIncumbente(abiertos[pendientes].cota, 0) < incumbente.load() && !busquedaInterrumpida)
+    {
+        pendientes++;
+    }
+    ejecutarConRobo(pendientes, numHilos, [&](size_t t, int)
+                    {
+        Estado estado(N);
+        estado.tarea = (uint32_t)t + 1;
+        cargarCamino(estado, arena, abiertos[t]);
+        TSP(estado, abiertos[t].profundidad, abiertos[t].costo);
+        nodosExpandidos += estado.nodos; });
+
+    costoMinimo = costoIncumbente();
+}
+
+/**********
+Objetivo: Branch and bound paralelo con robo de trabajo
+Entradas: El tipo de estado como parámetro de la plantilla (usa dist, N y numHilos)
+Salidas: Nada, actualiza caminoMin y costoMinimo
+Complejidad: O(n! / P) en el peor caso, donde P es el número de hilos. El árbol se corta a poca
+             profundidad en prefijos (uno por tarea, en orden lexicográfico) que se reparten en un pool
+             con robo de trabajo; el incumbente atómico hace que un recorrido encontrado en un hilo
+             pode de inmediato a los demás.
+***********/
+template <typename Estado>
+void branchAndBoundCon()
+{
+    if (busquedaTSP == BUSQUEDA_MEJOR)
+    {
+        mejorPrimero<Estado>();
+        return;
+    }
+
+    // Profundidad del corte: suficientes tareas para balancear la carga entre los hilos
+    int profundidad = 0;
+    long long tareas = 1;
+    while (numHilos > 1 && profundidad < N - 2 && profundidad < 4 && tareas < 16LL * numHilos)
+    {
+        tareas *= N - 1 - profundidad;
+        profundidad++;
+    }
+
+    // Prefijos 0, a, b, ... en orden lexicográfico
+    vector<vector<int>> prefijos;
+    vector<int> prefijo = {0};
+    vector<bool> usado(N, false);
+    usado[0] = true;
+    auto generar = [&](auto &&self) -> void
+    {
+        if ((int)prefijo.size() == profundidad + 1)
+        {
+            prefijos.push_back(prefijo);
+            return;
+        }
+        for (int i = 0; i < N; i++)
+        {
+            if (!usado[i])
+            {
+                usado[i] = true;
+                prefijo.push_back(i);
+                self(self);
+                prefijo.pop_back();
+                usado[i] = false;
+            }
+        }
+    };
+    generar(generar);
+
+    ejecutarConRobo(prefijos.size(), numHilos, [&](size_t t, int)
+                    {
+        Estado estado(N);
+        estado.tarea = (uint32_t)t;
+        int costo = 0;
+        for (size_t k = 0; k < prefijos[t].size(); k++)
+        {
+            estado.camino[k] = prefijos[t][k];
+            estado.marcar(prefijos[t][k]);
+            if (k > 0)
+                costo += dist[prefijos[t][k - 1]][prefijos[t][k]];
+        }
+        TSP(estado, prefijos[t].size(), costo);
+        nodosExpandidos += estado.nodos; });
+
+    costoMinimo = (int)(incumbente.load() >> 32);
+}
+
+bool kernelFijo = true; // false: usar siempre EstadoTSP (--kernel=generico), para comparar
+
+/**********
+Objetivo: Correr el branch and bound con EstadoFijo<MAXN, Costo>
+Entradas: Nada (usa dist y N <= MAXN)
+Salidas: Nada, actualiza caminoMin y costoMinimo
+Complejidad: O(MAXN^2) para llenar las matrices planas más el branch and bound
+***********/
+template <int MAXN, typename Costo>
+void branchAndBoundMatriz()
+{
+    using Estado = EstadoFijo<MAXN, Costo>;
+    Estado::matriz.assign((size_t)MAXN * MAXN, 0);
+    Estado::matrizT.assign((size_t)MAXN * MAXN, 0);
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            Estado::matriz[(size_t)i * MAXN + j] = Estado::matrizT[(size_t)j * MAXN + i] = dist[i][j];
+    Estado::minimo = elegirMinimoEnmascarado<Costo>();
+    if (Estado::CON_TABLA)
+    {
+        prepararTabla();
+    }
+    branchAndBoundCon<Estado>();
+    tablaActiva = false;
+}
+
+// Con N <= MAXN usa celdas de uint16_t si todas las distancias caben y de int si no
+template <int MAXN>
+void branchAndBoundFijo()
+{
+    bool cabe16 = true;
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            cabe16 &= dist[i][j] >= 0 && dist[i][j] <= UINT16_MAX;
+
+    if (cabe16)
+        branchAndBoundMatriz<MAXN, uint16_t>();
+    else
+        branchAndBoundMatriz<MAXN, int>();
+}
+
+/**********
+Objetivo: Elegir el kernel del branch and bound según N
+Entradas: Nada (usa dist, N y numHilos)
+Salidas: Nada, actualiza caminoMin y costoMinimo
+Complejidad: La de branchAndBoundCon(); con N <= 256 se usa el estado especializado más chico que cabe y
+             con N mayor el genérico
+***********/
+void branchAndBound()
+{
+    if (kernelFijo && N <= 64)
+        branchAndBoundFijo<64>();
+    else if (kernelFijo && N <= 128)
+        branchAndBoundFijo<128>();
+    else if (kernelFijo && N <= 256)
+        branchAndBoundFijo<256>();
+    else
+        branchAndBoundCon<EstadoTSP>();
+}
+
+/**********
+Objetivo: Memoria que necesita la tabla de Held-Karp
+Entradas: El número de nodos
+Salidas: Los bytes de la tabla (2^(N-1) subconjuntos por N-1 nodos finales, 4 bytes cada uno); arriba
+         de 31 nodos, ULLONG_MAX porque las máscaras de heldKarp() son de 32 bits
+Complejidad: O(1)
+***********/
+unsigned long long memoriaHeldKarp(int n)
+{
+    if (n < 2 || n > 31)
+    {
+        return n < 2 ? 0 : ULLONG_MAX;
+    }
+    return (1ULL << (n - 1)) * (n - 1) * sizeof(uint32_t);
+}
+
+/**********
+Objetivo: Revisar que los costos de Held-Karp quepan en la tabla de uint32
+Entradas: Nada (usa dist y N)
+Salidas: Verdadero si no hay distancias negativas y N * max(dist) es menor que UINT32_MAX, así que
+         ninguna suma de un camino parcial ni del ciclo completo se desborda ni choca con SIN_CAMINO
+Complejidad: O(N^2)
+***********/
+bool costosCabenHeldKarp()
+{
+    long long maximo = 0;
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+        {
+            if (dist[i][j] < 0)
+                return false;
+            maximo = max(maximo, (long long)dist[i][j]);
+        }
+    return maximo * N < UINT32_MAX;
+}
+
+/**********
+Objetivo: Calcular el recorrido mínimo exacto con programación dinámica de Held-Karp
+Entradas: Nada (usa dist y N); el nodo 0 es el inicio y los subconjuntos son de los nodos 1..N-1
+Salidas: Nada, actualiza caminoMin y costoMinimo
+Complejidad: O(2^N * N^2) de tiempo y O(2^N * N) de espacio. La tabla guarda, por cada subconjunto
+             (máscara de bits), una fila contigua de costos uint32 por nodo final; cada capa de
+             subconjuntos del mismo tamaño solo depende de la anterior y se evalúa en paralelo.
+***********/
+void heldKarp()
+{
+    const int n = N - 1; // nodos sin contar el 0
+    const uint32_t SIN_CAMINO = UINT32_MAX;
+
+    // Matriz plana de distancias: d[i * N + j]
+    vector<uint32_t> d((size_t)N * N);
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            d[(size_t)i * N + j] = dist[i][j];
+
+    // tabla[mascara * n + j]: costo mínimo de salir de 0, visitar los nodos de la máscara y terminar en j + 1
+    vector<uint32_t> tabla((size_t)n << n, SIN_CAMINO);
+    for (int j = 0; j < n; j++)
+    {
+        tabla[((size_t)1 << j) * n + j] = d[j + 1];
+    }
+
+    vector<uint32_t> capa;
+    for (int tam = 2; tam <= n; tam++)
+    {
+        // Máscaras con 'tam' bits encendidos (truco de Gosper)
+        capa.clear();
+        for (uint32_t mascara = (1u << tam) - 1; mascara < (1u << n);)
+        {
+            capa.push_back(mascara);
+            uint32_t c = mascara & -mascara, r = mascara + c;
+            mascara = (((r ^ mascara) >> 2) / c) | r;
+        }
+
+        int hilos = capa.size() * n * n < (1u << 16) ? 1 : numHilos;
+        paraleloEnBloques(capa.size(), hilos, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t k = inicio; k < fin; k++)
+            {
+                uint32_t mascara = capa[k];
+                uint32_t *fila = &tabla[(size_t)mascara * n];
+                for (int j = 0; j < n; j++)
+                {
+                    if (!(mascara >> j & 1))
+                        continue;
+                    const uint32_t *anterior = &tabla[(size_t)(mascara ^ (1u << j)) * n];
+                    uint32_t mejor = SIN_CAMINO;
+                    for (int i = 0; i < n; i++)
+                    {
+                        if (i != j && (mascara >> i & 1) && anterior[i] != SIN_CAMINO)
+                            mejor = min(mejor, anterior[i] + d[(size_t)(i + 1) * N + j + 1]);
+                    }
+                    fila[j] = mejor;
+                }
+            } });
+    }
+
+    // Cerrar el ciclo regresando al nodo 0
+    uint32_t completa = (1u << n) - 1;
+    uint32_t mejorCosto = SIN_CAMINO;
+    int ultimo = 0;
+    for (int j = 0; j < n; j++)
+    {
+        uint32_t costo = tabla[(size_t)completa * n + j] + d[(size_t)(j + 1) * N];
+        if (costo < mejorCosto)
+        {
+            mejorCosto = costo;
+            ultimo = j;
+        }
+    }
+
+    // Reconstruir el camino hacia atrás buscando el predecesor que da el valor de la tabla
+    caminoMin[0] = 0;
+    uint32_t mascara = completa;
+    for (int pos = N - 1; pos >= 1; pos--)
+    {
+        caminoMin[pos] = ultimo + 1;
+        uint32_t valor = tabla[(size_t)mascara * n + ultimo];
+        uint32_t sinUltimo = mascara ^ (1u << ultimo);
+        for (int i = 0; i < n && sinUltimo; i++)
+        {
+            if ((sinUltimo >> i & 1) && tabla[(size_t)sinUltimo * n + i] + d[(size_t)(i + 1) * N + ultimo + 1] == valor)
+            {
+                ultimo = i;
+                break;
+            }
+        }
+        mascara = sinUltimo;
+    }
+    costoMinimo = mejorCosto;
+}
+
+const double BRECHA_HELD_KARP = 0.25; // Brecha relativa en la raíz desde la que "auto" prefiere Held-Karp
+
+/**********
+Objetivo: Usar el recorrido heurístico como incumbente inicial del branch and bound
+Entradas: Nada
+Salidas: Nada, deja el recorrido en caminoMin y su costo en incumbente (con la tarea más alta, para
+         que un recorrido del mismo costo encontrado por la búsqueda exacta lo reemplace)
+Complejidad: La de recorridoHeuristico()
+***********/
+void sembrarIncumbente()
+{
+    long long costo;
+    vector<int> ruta = recorridoHeuristico(costo);
+    if (costo < INF)
+    {
+        caminoMin = ruta;
+        incumbente = llaveIncumbente((int)costo, UINT32_MAX);
+        costoMinimo = (int)costo;
+        reportarIncumbente(costo);
+    }
+}
+
+/**********
+Objetivo: Calcular una cota inferior barata en la raíz, antes de cualquier otra etapa
+Entradas: Nada (usa dist y N)
+Salidas: Nada, deja en cotaRaiz el mayor entre la suma de la arista de salida más barata de cada nodo
+         y la suma de la de entrada más barata (todo recorrido sale y entra una vez de cada nodo). Usa a lo
+         más la mitad del tiempo que queda; si no le alcanza no cambia cotaRaiz.
+Complejidad: O(N^2)
+***********/
+void cotaDosMinimos()
+{
+    if (N < 2)
+    {
+        return;
+    }
+    auto mitad = (fechaLimite - chrono::steady_clock::now()) / 2;
+    long long salida = 0, entrada = 0;
+    vector<int> minEntrada(N, INT_MAX); // Se llena por filas para leer dist en orden
+    for (int i = 0; i < N; i++)
+    {
+        if (quedaMenosDe(mitad))
+        {
+            return;
+        }
+        int minSalida = INT_MAX;
+        for (int j = 0; j < N; j++)
+        {
+            if (j != i)
+            {
+                minSalida = min(minSalida, dist[i][j]);
+                minEntrada[j] = min(minEntrada[j], dist[i][j]);
+            }
+        }
+        salida += minSalida;
+    }
+    for (int j = 0; j < N; j++)
+    {
+        entrada += minEntrada[j];
+    }
+    cotaRaiz = max({cotaRaiz, salida, entrada});
+}
+
+/**********
+Objetivo: Reportar en la salida de error qué tan lejos quedó el incumbente de la cota inferior
+Entradas: Nada
+Salidas: Nada. Si la búsqueda terminó o la cota ya alcanzó al incumbente, el incumbente es óptimo; si se
+         cortó por tiempo, la brecha se mide contra la mejor cota de la raíz que se alcanzó a calcular
+         (1-árbol penalizado o dos mínimos).
+Complejidad: O(1)
+***********/
+void reportarBrecha()
+{
+    if (!busquedaInterrumpida || cotaRaiz >= costoMinimo)
+    {
+        cerr << "optimo " << costoMinimo << endl;
+        return;
+    }
+    double brecha = costoMinimo > 0 ? 100.0 * (costoMinimo - cotaRaiz) / costoMinimo : 0.0;
+    cerr << "tiempo agotado: incumbente " << costoMinimo << " cota inferior " << cotaRaiz << " brecha " << brecha << "%" << endl;
+}
+
+/**********
+Objetivo: Seleccionar y ejecutar el motor de TSP
+Entradas: El motor: "auto", "bb" (branch and bound), "heldkarp", "heuristico" o "christofides"
+Salidas: Nada, actualiza caminoMin y costoMinimo
+Complejidad: La del motor elegido. En "auto" se estima antes: con la brecha en la raíz entre la cota del
+             1-árbol penalizado y el incumbente heurístico pequeña (instancias euclidianas o simétricas)
+             el branch and bound poda casi todo y termina mucho antes que el O(2^N N^2) de Held-Karp, así
+             que Held-Karp solo se usa a partir de 12 nodos, si su tabla cabe en memoriaMaximaTSP y si la
+             brecha es de al menos BRECHA_HELD_KARP (matrices asimétricas o arbitrarias). "auto" es exacto
+             con cualquier N; la heurística sola es "heuristico". Si la tabla no cabe o los costos no caben
+             en 32 bits (costosCabenHeldKarp()), "heldkarp" usa el branch and bound.
+***********/
+void resolverTSP(const string &motor)
+{
+    if (conFechaLimite)
+    {
+        iniciarFechaLimite();
+    }
+    if (motor == "christofides")
+    {
+        long long costo;
+        caminoMin = recorridoChristofides(costo);
+        costoMinimo = (int)costo;
+        return;
+    }
+
+    // Held-Karp no se puede interrumpir, así que en modo anytime no se usa (main() rechaza --tsp=heldkarp)
+    bool cabe = N >= 3 && memoriaHeldKarp(N) <= memoriaMaximaTSP && costosCabenHeldKarp();
+    if (motor == "heldkarp" && cabe)
+    {
+        heldKarp();
+        return;
+    }
+    // Con N < 3 hay un solo recorrido posible; branch and bound lo resuelve sin necesidad de avisar
+    if (motor == "heldkarp" && N >= 3)
+    {
+        cerr << "Held-Karp no aplica (tabla o costos fuera de rango); se usa branch and bound" << endl;
+    }
+
+    if (conFechaLimite)
+    {
+        cotaDosMinimos(); // Para que la brecha tenga contra qué medirse aunque no acabe ni una iteración
+    }
+    sembrarIncumbente();
+    if (motor == "heuristico")
+    {
+        return;
+    }
+
+    bool estimar = motor == "auto" && cabe && N >= 12 && !conFechaLimite;
+    if (cotaTSP == COTA_LAGRANGE || estimar)
+    {
+        calcularPenalizaciones(50);
+    }
+    if (estimar && costoMinimo - cotaRaiz >= BRECHA_HELD_KARP * costoMinimo)
+    {
+        heldKarp();
+        return;
+    }
+    if (cotaTSP != COTA_LAGRANGE)
+    {
+        calcularPenalizaciones(0); // Sin iteraciones quedan en cero (la cota simple no las usa)
+    }
+
+    if (prepararVecinos())
+    {
+        branchAndBound(); // El primer nodo visitado es el 0
+    }
+    else
+    {
+        busquedaInterrumpida = true; // Sin tiempo ni para preparar la búsqueda exacta
+    }
+
+    if (conFechaLimite)
+    {
+        reportarBrecha();
+    }
+}
+
+/*
+***************************
+***************************
+TRAVELLING SALESMAN PROBLEM - END
+***************************
+***************************
+*/
+
+// Estructura para representar una arista con sus respectivos nodos y peso
+struct Arista
+{
+    int nodoA, nodoB, peso;
+
+    Arista(int a, int b, int w) : nodoA(a), nodoB(b), peso(w) {}
+};
+
+// Función para comparar aristas, utilizada para ordenar las aristas según su peso
+bool comparaAristas(const Arista &a, const Arista &b)
+{
+    return a.peso < b.peso;
+}
+
+// Función que encuentra el padre de un nodo en un conjunto disjunto
+// Complejidad de tiempo: O(log N), donde N es el número de nodos
+// Complejidad de espacio: O(1), ya que no usa espacio adicional
+// Es iterativa (dos pasadas) para no desbordar la pila en cadenas largas
+int encontrarPadre(vector<int> &padre, int nodo)
+{
+    int raiz = nodo;
+    while (padre[raiz] != raiz)
+        raiz = padre[raiz];
+    while (padre[nodo] != raiz)
+    {
+        int siguiente = padre[nodo];
+        padre[nodo] = raiz;
+        nodo = siguiente;
+    }
+    return raiz;
+}
+
+// Función para unir dos conjuntos en un conjunto disjunto
+// Complejidad de tiempo: O(log N), donde N es el número de nodos
+// Complejidad de espacio: O(1), ya que no usa espacio adicional
+void unirConjuntos(vector<int> &padre, int nodoA, int nodoB)
+{
+    int padreA = encontrarPadre(padre, nodoA);
+    int padreB = encontrarPadre(padre, nodoB);
+    padre[padreA] = padreB;
+}
+
+// Algoritmo de Kruskal
+// Complejidad de tiempo: O(E * log(E)), donde E es el número de aristas
+// Complejidad de espacio: O(V + E), donde V es el número de nodos
+vector<Arista> kruskal(int N, vector<Arista> aristas)
+{
+    int numNodos = N;
+    vector<int> padre(N);
+    vector<Arista> mst; // Árbol de expansión mínima
+
+    // Inicializar conjunto disjunto
+    for (int i = 0; i < N; ++i)
+    {
+        padre[i] = i;
+    }
+
+    // Ordenar aristas por peso
+    sort(aristas.begin(), aristas.end(), comparaAristas);
+
+    for (Arista &arista : aristas)
+    {
+        int nodoA = arista.nodoA;
+        int nodoB = arista.nodoB;
+
+        // Verificar que los nodos no estén ya conectados
+        if (encontrarPadre(padre, nodoA) != encontrarPadre(padre, nodoB))
+        {
+            mst.push_back(arista);
+            unirConjuntos(padre, nodoA, nodoB);
+            numNodos--;
+
+            // Todas las colonias conectadas
+            if (numNodos == 1)
+            {
+                break;
+            }
+        }
+    }
+
+    return mst;
+}
+
+// Conjunto disjunto con unión por tamaño y compresión de caminos iterativa
+// Complejidad de tiempo: O(α(N)) amortizado por operación
+// Complejidad de espacio: O(N)
+struct ConjuntoDisjunto
+{
+    vector<int> padre, tamano;
+
+    ConjuntoDisjunto(int n) : padre(n), tamano(n, 1)
+    {
+        iota(padre.begin(), padre.end(), 0);
+    }
+
+    int encontrar(int nodo)
+    {
+        return encontrarPadre(padre, nodo);
+    }
+
+    // Búsqueda sin compresión: no modifica la estructura, así que varios hilos pueden consultarla a la vez
+    int encontrarSoloLectura(int nodo) const
+    {
+        while (padre[nodo] != nodo)
+            nodo = padre[nodo];
+        return nodo;
+    }
+
+    // Une los conjuntos de a y b; regresa false si ya estaban unidos
+    bool unir(int a, int b)
+    {
+        a = encontrar(a);
+        b = encontrar(b);
+        if (a == b)
+            return false;
+        if (tamano[a] < tamano[b])
+            swap(a, b);
+        padre[b] = a;
+        tamano[a] += tamano[b];
+        return true;
+    }
+};
+
+const size_t UMBRAL_FILTER_KRUSKAL = 1 << 14; // Debajo de este número de aristas se ordena directamente
+const size_t UMBRAL_PARALELO = 1 << 15;       // Debajo de este número de elementos no conviene crear hilos
+
+// Parte las aristas en ligeras (peso <= pivote) y pesadas (peso > pivote) en paralelo
+// Cada hilo cuenta sus ligeras, se calculan los desplazamientos y luego cada hilo escribe su bloque
+// Complejidad de tiempo: O(E / P), donde P es el número de hilos
+void particionParalela(const vector<Arista> &aristas, int pivote, vector<Arista> &ligeras, vector<Arista> &pesadas)
+{
+    int hilos = aristas.size() < UMBRAL_PARALELO ? 1 : numHilos;
+    vector<size_t> cuentaLigeras(hilos + 1, 0), cuentaPesadas(hilos + 1, 0);
+    paraleloEnBloques(aristas.size(), hilos, [&](size_t inicio, size_t fin, int h)
+                      {
+        size_t c = 0;
+        for (size_t i = inicio; i < fin; ++i)
+            c += aristas[i].peso <= pivote;
+        cuentaLigeras[h + 1] = c;
+        cuentaPesadas[h + 1] = (fin - inicio) - c; });
+    for (int h = 0; h < hilos; ++h)
+    {
+        cuentaLigeras[h + 1] += cuentaLigeras[h];
+        cuentaPesadas[h + 1] += cuentaPesadas[h];
+    }
+
+    ligeras.assign(cuentaLigeras[hilos], Arista(0, 0, 0));
+    pesadas.assign(cuentaPesadas[hilos], Arista(0, 0, 0));
+    paraleloEnBloques(aristas.size(), hilos, [&](size_t inicio, size_t fin, int h)
+                      {
+        size_t l = cuentaLigeras[h], p = cuentaPesadas[h];
+        for (size_t i = inicio; i < fin; ++i)
+        {
+            if (aristas[i].peso <= pivote)
+                ligeras[l++] = aristas[i];
+            else
+                pesadas[p++] = aristas[i];
+        } });
+}
+
+// Conserva en paralelo solo las aristas que cumplen conservar(arista), manteniendo su orden
+// Cada hilo evalúa su bloque, se calculan los desplazamientos y luego cada hilo copia sus aristas
+// Complejidad de tiempo: O(E / P), donde P es el número de hilos
+template <typename Predicado>
+void filtrarParalelo(vector<Arista> &aristas, Predicado conservar)
+{
+    int hilos = aristas.size() < UMBRAL_PARALELO ? 1 : numHilos;
+    vector<size_t> cuenta(hilos + 1, 0);
+    vector<char> marca(aristas.size());
+    paraleloEnBloques(aristas.size(), hilos, [&](size_t inicio, size_t fin, int h)
+                      {
+        size_t c = 0;
+        for (size_t i = inicio; i < fin; ++i)
+        {
+            marca[i] = conservar(aristas[i]);
+            c += marca[i];
+        }
+        cuenta[h + 1] = c; });
+    for (int h = 0; h < hilos; ++h)
+    {
+        cuenta[h + 1] += cuenta[h];
+    }
+
+    vector<Arista> filtradas(cuenta[hilos], Arista(0, 0, 0));
+    paraleloEnBloques(aristas.size(), hilos, [&](size_t inicio, size_t fin, int h)
+                      {
+        size_t k = cuenta[h];
+        for (size_t i = inicio; i < fin; ++i)
+            if (marca[i])
+                filtradas[k++] = aristas[i]; });
+    aristas.swap(filtradas);
+}
+
+// Paso recursivo de Filter-Kruskal: primero se resuelven las aristas ligeras, y las pesadas
+// solo se ordenan después de descartar las que ya quedaron conectadas
+void filterKruskalRecursivo(vector<Arista> &aristas, ConjuntoDisjunto &conjuntos, vector<Arista> &mst, int N)
+{
+    if ((int)mst.size() >= N - 1 || aristas.empty())
+    {
+        return;
+    }
+
+    // Pivote: mediana de una muestra uniforme de pesos
+    vector<int> muestra;
+    if (aristas.size() > UMBRAL_FILTER_KRUSKAL)
+    {
+        size_t paso = aristas.size() / 31;
+        for (size_t i = 0; i < aristas.size(); i += paso)
+            muestra.push_back(aristas[i].peso);
+        nth_element(muestra.begin(), muestra.begin() + muestra.size() / 2, muestra.end());
+    }
+
+    vector<Arista> ligeras, pesadas;
+    if (!muestra.empty())
+    {
+        particionParalela(aristas, muestra[muestra.size() / 2], ligeras, pesadas);
+    }
+
+    // Caso base: pocas aristas, o el pivote no logra partir (todas las aristas pesan lo mismo o menos)
+    if (muestra.empty() || pesadas.empty())
+    {
+        sort(aristas.begin(), aristas.end(), comparaAristas);
+        for (Arista &arista : aristas)
+        {
+            if (conjuntos.unir(arista.nodoA, arista.nodoB))
+            {
+                mst.push_back(arista);
+                if ((int)mst.size() == N - 1)
+                    break;
+            }
+        }
+        return;
+    }
+
+    vector<Arista>().swap(aristas); // Liberar la memoria antes de bajar en la recursión
+    filterKruskalRecursivo(ligeras, conjuntos, mst, N);
+    if ((int)mst.size() < N - 1)
+    {
+        // Descartar las aristas cuyos extremos ya están conectados; la búsqueda sin compresión no escribe
+        filtrarParalelo(pesadas, [&conjuntos](const Arista &a)
+                        { return conjuntos.encontrarSoloLectura(a.nodoA) != conjuntos.encontrarSoloLectura(a.nodoB); });
+        filterKruskalRecursivo(pesadas, conjuntos, mst, N);
+    }
+}
+
+// Algoritmo Filter-Kruskal con partición y filtrado en paralelo
+// Complejidad de tiempo: O(E + V log V log(E / V)) esperado, con la partición y el filtro divididos entre los hilos
+// Complejidad de espacio: O(V + E)
+vector<Arista> filterKruskal(int N, vector<Arista> aristas)
+{
+    vector<Arista> mst;
+    ConjuntoDisjunto conjuntos(max(N, 0));
+    filterKruskalRecursivo(aristas, conjuntos, mst, N);
+    return mst;
+}
+
+// Llave de orden total para Borůvka: peso en los 32 bits altos y el índice de la arista en los bajos
+// Desempatar por índice garantiza que las aristas elegidas en una ronda no formen ciclos
+inline uint64_t llaveArista(const Arista &arista, size_t indice)
+{
+    return ((uint64_t)((uint32_t)arista.peso ^ 0x80000000u) << 32) | (uint32_t)indice;
+}
+
+// Mínimo atómico sin candados
+inline void minimoAtomico(atomic<uint64_t> &destino, uint64_t valor)
+{
+    uint64_t actual = destino.load(memory_order_relaxed);
+    while (valor < actual && !destino.compare_exchange_weak(actual, valor, memory_order_relaxed))
+    {
+    }
+}
+
+// Algoritmo de Borůvka paralelo
+// En cada ronda todas las componentes eligen en paralelo su arista de salida más barata (mínimo atómico),
+// se enganchan a la componente vecina y se aplanan con saltos de apuntador, sin candados.
+// Complejidad de tiempo: O((E + V) log V / P), donde P es el número de hilos
+// Complejidad de espacio: O(V + E)
+vector<Arista> boruvkaParalelo(int N, vector<Arista> aristas)
+{
+    vector<Arista> mst;
+    if (N <= 1)
+    {
+        return mst;
+    }
+
+    const uint64_t SIN_ARISTA = UINT64_MAX;
+    vector<int> componente(N);          // Componente (nodo representante) de cada nodo
+    vector<int> apuntador(N), salto(N); // Enganche de cada componente y su versión tras un salto
+    vector<atomic<uint64_t>> mejor(N);  // Arista más barata que sale de cada componente
+    vector<char> agregar(N);
+    iota(componente.begin(), componente.end(), 0);
+
+    // Las aristas internas nunca sirven
+    filtrarParalelo(aristas, [](const Arista &a)
+                    { return a.nodoA != a.nodoB; });
+
+    while (!aristas.empty() && (int)mst.size() < N - 1)
+    {
+        int hilosNodos = N < (int)UMBRAL_PARALELO ? 1 : numHilos;
+        int hilosAristas = aristas.size() < UMBRAL_PARALELO ? 1 : numHilos;
+
+        paraleloEnBloques(N, hilosNodos, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t c = inicio; c < fin; ++c)
+                mejor[c].store(SIN_ARISTA, memory_order_relaxed); });
+
+        // 1. Arista más barata de cada componente
+        paraleloEnBloques(aristas.size(), hilosAristas, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t i = inicio; i < fin; ++i)
+            {
+                uint64_t llave = llaveArista(aristas[i], i);
+                minimoAtomico(mejor[componente[aristas[i].nodoA]], llave);
+                minimoAtomico(mejor[componente[aristas[i].nodoB]], llave);
+            } });
+
+        // 2. Cada componente se engancha a la vecina de su arista; en los pares mutuos el menor queda como raíz
+        paraleloEnBloques(N, hilosNodos, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t c = inicio; c < fin; ++c)
+            {
+                apuntador[c] = (int)c;
+                uint64_t llave = mejor[c].load(memory_order_relaxed);
+                if (componente[c] != (int)c || llave == SIN_ARISTA)
+                    continue;
+                const Arista &arista = aristas[(uint32_t)llave];
+                apuntador[c] = componente[arista.nodoA] == (int)c ? componente[arista.nodoB] : componente[arista.nodoA];
+            } });
+        paraleloEnBloques(N, hilosNodos, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t c = inicio; c < fin; ++c)
+            {
+                int d = apuntador[c];
+                bool mutuo = apuntador[d] == (int)c;
+                agregar[c] = d != (int)c && !(mutuo && (int)c < d);
+                salto[c] = mutuo && (int)c < d ? (int)c : d;
+            } });
+
+        for (int c = 0; c < N; ++c)
+        {
+            if (agregar[c])
+            {
+                mst.push_back(aristas[(uint32_t)mejor[c].load(memory_order_relaxed)]);
+            }
+        }
+
+        // 3. Saltos de apuntador hasta que cada componente apunte a su raíz
+        bool cambio = true;
+        while (cambio)
+        {
+            apuntador.swap(salto);
+            vector<char> cambioHilo(hilosNodos, 0);
+            paraleloEnBloques(N, hilosNodos, [&](size_t inicio, size_t fin, int h)
+                              {
+                for (size_t c = inicio; c < fin; ++c)
+                {
+                    salto[c] = apuntador[apuntador[c]];
+                    cambioHilo[h] |= salto[c] != apuntador[c];
+                } });
+            cambio = find(cambioHilo.begin(), cambioHilo.end(), 1) != cambioHilo.end();
+        }
+
+        // 4. Renombrar los nodos y descartar las aristas que quedaron dentro de una componente
+        paraleloEnBloques(N, hilosNodos, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t v = inicio; v < fin; ++v)
+                componente[v] = salto[componente[v]]; });
+        filtrarParalelo(aristas, [&componente](const Arista &a)
+                        { return componente[a.nodoA] != componente[a.nodoB]; });
+    }
+
+    return mst;
+}
+
+// Construye la lista de aristas (i < j) a partir de la matriz plana de distancias
+// Complejidad de tiempo: O(N^2), donde N es el número de nodos
+// Complejidad de espacio: O(N^2), una arista por par de nodos
+vector<Arista> aristasDeMatriz(int N, const vector<int> &matriz)
+{
+    vector<Arista> aristas;
+    aristas.reserve((size_t)N * (N - 1) / 2);
+    for (int i = 0; i < N; ++i)
+    {
+        for (int j = i + 1; j < N; ++j)
+        {
+            aristas.emplace_back(i, j, matriz[(size_t)i * N + j]);
+        }
+    }
+    return aristas;
+}
+
+// Algoritmo de Prim para grafos densos sobre la matriz plana de distancias (fila mayor)
+// No genera lista de aristas: en cada paso se toma el nodo fuera del árbol con la conexión más barata
+// y se actualizan las conexiones de los demás recorriendo su fila de la matriz.
+// Complejidad de tiempo: O(N^2), donde N es el número de nodos
+// Complejidad de espacio: O(N) adicional a la matriz
+vector<Arista> primDenso(int N, const vector<int> &matriz)
+{
+    vector<Arista> mst; // Árbol de expansión mínima
+    if (N <= 1)
+    {
+        return mst;
+    }
+    mst.reserve(N - 1);
+
+    vector<int> costo(N, INT_MAX); // Conexión más barata de cada nodo hacia el árbol
+    vector<int> padre(N, -1);      // Nodo del árbol que da esa conexión
+    vector<bool> enArbol(N, false);
+
+    int actual = 0;
+    enArbol[actual] = true;
+    for (int paso = 1; paso < N; ++paso)
+    {
+        // Relajar las conexiones con la fila del último nodo agregado
+        const int *fila = &matriz[(size_t)actual * N];
+        int siguiente = -1;
+        for (int v = 0; v < N; ++v)
+        {
+            if (enArbol[v])
+            {
+                continue;
+            }
+            if (fila[v] < costo[v])
+            {
+                costo[v] = fila[v];
+                padre[v] = actual;
+            }
+            if (siguiente == -1 || costo[v] < costo[siguiente])
+            {
+                siguiente = v;
+            }
+        }
+
+        mst.emplace_back(padre[siguiente], siguiente, costo[siguiente]);
+        enArbol[siguiente] = true;
+        actual = siguiente;
+    }
+
+    return mst;
+}
+
+// Árbol de expansión mínima dinámico sobre la matriz plana de distancias
+// Recibe actualizaciones "la arista (a, b) ahora cuesta w" y corrige el árbol sin recalcularlo:
+// - Si una arista fuera del árbol baja de precio, se busca la arista más cara del camino a-b en el árbol
+//   y se intercambian si la nueva es más barata. O(N)
+// - Si una arista del árbol sube de precio, se quita, se marca uno de los dos lados del corte y se busca
+//   la arista de reemplazo más barata que cruza el corte recorriendo la fila completa de cada nodo marcado.
+//   O(|S| * N) <= O(N^2), donde S es el lado marcado
+// - En los otros dos casos el árbol no cambia. O(grado)
+struct MSTDinamico
+{
+    int N;
+    vector<int> matriz;          // Matriz plana de distancias, se mantiene simétrica
+    vector<vector<int>> vecinos; // Lista de adyacencia del árbol
+    long long pesoTotal = 0;
+
+    MSTDinamico(int n, vector<int> m) : N(n), matriz(move(m)), vecinos(n)
+    {
+        for (const Arista &arista : primDenso(N, matriz))
+        {
+            agregar(arista);
+        }
+    }
+
+    int peso(int a, int b) const
+    {
+        return matriz[(size_t)a * N + b];
+    }
+
+    bool enArbol(int a, int b) const
+    {
+        return find(vecinos[a].begin(), vecinos[a].end(), b) != vecinos[a].end();
+    }
+
+    void agregar(const Arista &arista)
+    {
+        vecinos[arista.nodoA].push_back(arista.nodoB);
+        vecinos[arista.nodoB].push_back(arista.nodoA);
+        pesoTotal += arista.peso;
+    }
+
+    void quitar(int a, int b)
+    {
+        vecinos[a].erase(find(vecinos[a].begin(), vecinos[a].end(), b));
+        vecinos[b].erase(find(vecinos[b].begin(), vecinos[b].end(), a));
+        pesoTotal -= peso(a, b);
+    }
+
+    // Recorre el árbol desde origen y regresa el padre de cada nodo alcanzado (-1 si no se alcanzó)
+    vector<int> recorrer(int origen) const
+    {
+        vector<int> padre(N, -1), pila = {origen};
+        padre[origen] = origen;
+        while (!pila.empty())
+        {
+            int u = pila.back();
+            pila.pop_back();
+            for (int v : vecinos[u])
+            {
+                if (padre[v] == -1)
+                {
+                    padre[v] = u;
+                    pila.push_back(v);
+                }
+            }
+        }
+        return padre;
+    }
+
+    // Aplica una actualización y agrega a salieron / entraron las aristas que cambiaron en el árbol
+    void actualizar(int a, int b, int w, vector<Arista> &salieron, vector<Arista> &entraron)
+    {
+        if (a == b)
+        {
+            return;
+        }
+        int anterior = peso(a, b);
+        bool arbol = enArbol(a, b);
+        if (arbol)
+        {
+            pesoTotal += (long long)w - anterior;
+        }
+        matriz[(size_t)a * N + b] = matriz[(size_t)b * N + a] = w;
+
+        if (arbol && w > anterior)
+        {
+            // Se quita la arista y se busca la más barata que reconecte los dos lados (la misma si sigue siendo la mejor)
+            quitar(a, b);
+            vector<int> lado = recorrer(a);
+            Arista mejor(a, b, w);
+            for (int u = 0; u < N; ++u)
+            {
+                if (lado[u] == -1)
+                    continue;
+                const int *fila = &matriz[(size_t)u * N];
+                for (int v = 0; v < N; ++v)
+                {
+                    if (lado[v] == -1 && fila[v] < mejor.peso)
+                    {
+                        mejor = Arista(u, v, fila[v]);
+                    }
+                }
+            }
+            agregar(mejor);
+            if (mejor.nodoA != a || mejor.nodoB != b)
+            {
+                salieron.emplace_back(a, b, anterior);
+                entraron.push_back(mejor);
+            }
+        }
+        else if (!arbol && w < anterior)
+        {
+            // La arista más cara del camino a-b en el árbol es la candidata a salir
+            vector<int> padre = recorrer(a);
+            int peorU = -1, peorV = -1;
+            for (int v = b; v != a; v = padre[v])
+            {
+                if (peorU == -1 || peso(padre[v], v) > peso(peorU, peorV))
+                {
+                    peorU = padre[v];
+                    peorV = v;
+                }
+            }
+            if (peso(peorU, peorV) > w)
+            {
+                salieron.emplace_back(peorU, peorV, peso(peorU, peorV));
+                quitar(peorU, peorV);
+                agregar(Arista(a, b, w));
+                entraron.emplace_back(a, b, w);
+            }
+        }
+    }
+
+    // Aristas actuales del árbol
+    vector<Arista> aristas() const
+    {
+        vector<Arista> resultado;
+        for (int u = 0; u < N; ++u)
+            for (int v : vecinos[u])
+                if (u < v)
+                    resultado.emplace_back(u, v, peso(u, v));
+        return resultado;
+    }
+
+    // Deja en salieron / entraron solo el cambio neto de un lote: cada salida de una arista se cancela
+    // con una entrada de la misma arista. Quedan la primera salida (peso previo al lote) y la última
+    // entrada (peso actual).
+    static void cambioNeto(vector<Arista> &salieron, vector<Arista> &entraron)
+    {
+        auto llave = [](const Arista &arista)
+        { return make_pair(min(arista.nodoA, arista.nodoB), max(arista.nodoA, arista.nodoB)); };
+        map<pair<int, int>, int> cuentaSalidas, cuentaEntradas;
+        for (const Arista &arista : salieron)
+            ++cuentaSalidas[llave(arista)];
+        for (const Arista &arista : entraron)
+            ++cuentaEntradas[llave(arista)];
+        map<pair<int, int>, int> cancelarSalidas, cancelarEntradas;
+        for (const auto &[arista, cuenta] : cuentaSalidas)
+        {
+            auto it = cuentaEntradas.find(arista);
+            if (it != cuentaEntradas.end())
+                cancelarSalidas[arista] = cancelarEntradas[arista] = min(cuenta, it->second);
+        }
+        if (cancelarSalidas.empty())
+            return;
+
+        vector<Arista> netasSalidas, netasEntradas;
+        for (auto it = salieron.rbegin(); it != salieron.rend(); ++it)
+        {
+            auto c = cancelarSalidas.find(llave(*it));
+            if (c != cancelarSalidas.end() && c->second > 0)
+                --c->second;
+            else
+                netasSalidas.push_back(*it);
+        }
+        reverse(netasSalidas.begin(), netasSalidas.end());
+        for (const Arista &arista : entraron)
+        {
+            auto c = cancelarEntradas.find(llave(arista));
+            if (c != cancelarEntradas.end() && c->second > 0)
+                --c->second;
+            else
+                netasEntradas.push_back(arista);
+        }
+        salieron = move(netasSalidas);
+        entraron = move(netasEntradas);
+    }
+};
+
+// Distancia euclidiana entre dos centrales, redondeada al entero más cercano
+int pesoEuclidiano(const pair<int, int> &a, const pair<int, int> &b)
+{
+    double dx = (double)a.first - b.first;
+    double dy = (double)a.second - b.second;
+    return (int)llround(sqrt(dx * dx + dy * dy));
+}
+
+// Aristas de la triangulación de Delaunay de las centrales, con su peso euclidiano redondeado
+// Las centrales repetidas se conectan a la primera con su coordenada con peso 0
+// Complejidad de tiempo: la de delaunay_triangulation() más O(N log N)
+// Complejidad de espacio: O(N)
+vector<Arista> aristasDelaunay(const vector<pair<int, int>> &centrales)
+{
+    int N = centrales.size();
+    vector<Arista> aristas;
+
+    // Índice de cada coordenada; las centrales repetidas se conectan a la primera con peso 0
+    map<pair<int, int>, int> indice;
+    vector<delaunay::Point> puntos;
+    for (int i = 0; i < N; ++i)
+    {
+        auto it = indice.find(centrales[i]);
+        if (it != indice.end())
+        {
+            aristas.emplace_back(it->second, i, 0);
+        }
+        else
+        {
+            indice[centrales[i]] = i;
+            puntos.emplace_back(centrales[i].first, centrales[i].second);
+        }
+    }
+
+    // Aristas de la triangulación entre centrales (se ignoran las que tocan el super triángulo)
+    vector<pair<int, int>> pares;
+    for (const delaunay::Triangulo &triangulo : delaunay::delaunay_triangulation(puntos))
+    {
+        for (const delaunay::Arista &arista : triangulo.getAristas())
+        {
+            auto a = indice.find({(int)arista.getP1().getX(), (int)arista.getP1().getY()});
+            auto b = indice.find({(int)arista.getP2().getX(), (int)arista.getP2().getY()});
+            if (a == indice.end() || b == indice.end() ||
+                a->first.first != arista.getP1().getX() || a->first.second != arista.getP1().getY() ||
+                b->first.first != arista.getP2().getX() || b->first.second != arista.getP2().getY())
+            {
+                continue;
+            }
+            pares.push_back({min(a->second, b->second), max(a->second, b->second)});
+        }
+    }
+    sort(pares.begin(), pares.end());
+    pares.erase(unique(pares.begin(), pares.end()), pares.end());
+    for (const auto &par : pares)
+    {
+        aristas.emplace_back(par.first, par.second, pesoEuclidiano(centrales[par.first], centrales[par.second]));
+    }
+    return aristas;
+}
+
+// Árbol de expansión mínima euclidiano a partir de las coordenadas de las centrales
+// El MST euclidiano es un subgrafo de la triangulación de Delaunay, así que Kruskal solo necesita
+// sus O(N) aristas en lugar de las N^2 / 2 de la matriz. Redondear la distancia es monótono,
+// por lo que los pesos resultantes son los mismos que con la matriz de distancias redondeadas.
+// Complejidad de tiempo: la de delaunay_triangulation() más O(N log N) de Kruskal
+// Complejidad de espacio: O(N)
+vector<Arista> mstDelaunay(const vector<pair<int, int>> &centrales)
+{
+    int N = centrales.size();
+    vector<Arista> aristas = aristasDelaunay(centrales);
+    vector<Arista> mst = kruskal(N, move(aristas));
+
+    // Si la triangulación degeneró (por ejemplo, todas las centrales colineales) se usan todos los pares
+    if (N > 1 && (int)mst.size() < N - 1)
+    {
+        aristas.clear();
+        for (int i = 0; i < N; ++i)
+            for (int j = i + 1; j < N; ++j)
+                aristas.emplace_back(i, j, pesoEuclidiano(centrales[i], centrales[j]));
+        mst = kruskal(N, move(aristas));
+    }
+    return mst;
+}
+
+// Selecciona el motor de árbol de expansión mínima
+// "auto" (o "prim"): la entrada es una matriz completa, así que se usa Prim denso en O(N^2)
+// "kruskal": se genera la lista de aristas y se ordena, O(N^2 log N)
+// "filtro": Filter-Kruskal paralelo sobre la lista de aristas
+// "boruvka": Borůvka paralelo sobre la lista de aristas
+// "delaunay": MST euclidiano a partir de las coordenadas de las centrales, sin usar la matriz
+vector<Arista> arbolExpansionMinimo(const string &motor, int N, const vector<int> &matriz, const vector<pair<int, int>> &centrales)
+{
+    if (motor == "delaunay")
+    {
+        return mstDelaunay(centrales);
+    }
+    if (motor == "kruskal")
+    {
+        return kruskal(N, aristasDeMatriz(N, matriz));
+    }
+    if (motor == "filtro")
+    {
+        return filterKruskal(N, aristasDeMatriz(N, matriz));
+    }
+    if (motor == "boruvka")
+    {
+        return boruvkaParalelo(N, aristasDeMatriz(N, matriz));
+    }
+    return primDenso(N, matriz);
+}
+
+/*
+***************************
+TSP - COTA DE 1-ÁRBOL
+***************************
+*/
+vector<int> penalizacion; // Penalización de Held-Karp (Lagrange) de cada nodo; ceros si no se usan
+
+// Peso simétrico penalizado de la arista (i, j)
+inline int pesoPenalizado(int i, int j)
+{
+    return min(dist[i][j], dist[j][i]) + penalizacion[i] + penalizacion[j];
+}
+
+/**********
+Objetivo: Cota inferior con un 1-árbol sobre los nodos no visitados
+Entradas: El estado de la búsqueda, la posicion y el costo acumulado del camino
+Salidas: El costo del camino más una cota del resto: lo que falta es un camino hamiltoniano que sale del
+         nodo actual, pasa por todos los no visitados U y regresa al inicio. Sus aristas dentro de U forman
+         un árbol, así que cuesta al menos MST(U) + min d(actual, u) + min d(u, inicio). Con penalizaciones
+         en los nodos se suman a los pesos y se restan una vez por cada extremo que usan.
+Complejidad: O(u^2) donde u es el numero de nodos no visitados (Prim denso sobre U). Los arreglos son
+             por hilo y se reutilizan, así que un nodo del árbol de búsqueda no pide memoria.
+***********/
+template <typename Estado>
+int cotaUnoArbol(const Estado &estado, int pos, int costo)
+{
+    int suma = costo;
+
+    int actual = estado.camino[pos - 1], inicio = estado.camino[0];
+    thread_local vector<int> libres, conexion;
+    libres.clear();
+    estado.paraCadaLibre([&](int i)
+                         { libres.push_back(i); });
+
+    // Árbol de expansión mínima de los no visitados: Prim denso con índices locales. conexion[a] es el peso
+    // más barato de libres[a] al árbol; los que ya entraron se mueven al final de libres[0..resto)
+    int k = libres.size();
+    conexion.assign(k, INT_MAX);
+    for (int resto = k - 1; resto > 0; resto--)
+    {
+        // El último agregado está en libres[resto]; se relajan los que faltan y se toma el más barato
+        int nuevo = libres[resto], mejor = 0;
+        for (int a = 0; a < resto; a++)
+        {
+            conexion[a] = min(conexion[a], pesoPenalizado(nuevo, libres[a]));
+            if (conexion[a] < conexion[mejor])
+                mejor = a;
+        }
+        suma += conexion[mejor];
+        swap(libres[mejor], libres[resto - 1]);
+        swap(conexion[mejor], conexion[resto - 1]);
+    }
+
+    // Conexiones de los extremos del camino con U, y se quitan las penalizaciones sumadas de más
+    int minSalida = INF, minRegreso = INF;
+    for (int u : libres)
+    {
+        minSalida = min(minSalida, dist[actual][u] + penalizacion[u]);
+        minRegreso = min(minRegreso, dist[u][inicio] + penalizacion[u]);
+        suma -= 2 * penalizacion[u];
+    }
+    return suma + minSalida + minRegreso;
+}
+
+/**********
+Objetivo: Calcular las penalizaciones de Held-Karp con optimización por subgradiente en la raíz
+Entradas: El número máximo de iteraciones
+Salidas: Nada, deja en penalizacion las que dieron el mejor 1-árbol. En cada iteración se calcula el
+         1-árbol (MST de los nodos 1..N-1 con kruskal() más las dos aristas más baratas del nodo 0) y a cada
+         nodo se le sube la penalización si su grado es mayor a 2 y se le baja si es menor.
+Complejidad: O(iteraciones * N^2 log N)
+***********/
+void calcularPenalizaciones(int iteraciones)
+{
+    penalizacion.assign(N, 0);
+    if (N < 3 || tiempoAgotado())
+    {
+        return;
+    }
+
+    // Cota superior para el tamaño de paso: recorrido del vecino más cercano desde 0
+    auto inicio = chrono::steady_clock::now();
+    long long superior = 0;
+    {
+        vector<bool> usado(N, false);
+        int actual = 0;
+        usado[0] = true;
+        for (int paso = 1; paso < N; paso++)
+        {
+            if (tiempoAgotado())
+            {
+                return; // Sin tiempo ni para el paso: las penalizaciones se quedan en cero
+            }
+            int siguiente = -1;
+            for (int v = 0; v < N; v++)
+                if (!usado[v] && (siguiente == -1 || dist[actual][v] < dist[actual][siguiente]))
+                    siguiente = v;
+            superior += dist[actual][siguiente];
+            usado[siguiente] = true;
+            actual = siguiente;
+        }
+        superior += dist[actual][0];
+    }
+
+    vector<int> mejores = penalizacion;
+    long long mejorCota = LLONG_MIN;
+    double lambda = 2.0;
+    int sinMejora = 0;
+    // Modo anytime: una iteración solo empieza si cabe antes de la fecha límite. Se estima con lo que
+    // tardó la anterior; la primera, con el O(N^2) del vecino más cercano por el log N del ordenamiento.
+    auto iteracion = 32 * (chrono::steady_clock::now() - inicio);
+    for (int it = 0; it < iteraciones && lambda > 1e-3 && !quedaMenosDe(iteracion); it++)
+    {
+        inicio = chrono::steady_clock::now();
+        // 1-árbol penalizado
+        vector<int> grado(N, 0);
+        long long cota = 0;
+        vector<Arista> aristas;
+        for (int a = 1; a < N; a++)
+            for (int b = a + 1; b < N; b++)
+                aristas.emplace_back(a - 1, b - 1, pesoPenalizado(a, b));
+        for (const Arista &arista : kruskal(N - 1, move(aristas)))
+        {
+            cota += arista.peso;
+            grado[arista.nodoA + 1]++;
+            grado[arista.nodoB + 1]++;
+        }
+        int primero = -1, segundo = -1;
+        for (int v = 1; v < N; v++)
+        {
+            if (primero == -1 || pesoPenalizado(0, v) < pesoPenalizado(0, primero))
+            {
+                segundo = primero;
+                primero = v;
+            }
+            else if (segundo == -1 || pesoPenalizado(0, v) < pesoPenalizado(0, segundo))
+            {
+                segundo = v;
+            }
+        }
+        cota += pesoPenalizado(0, primero) + pesoPenalizado(0, segundo);
+        grado[0] = 2;
+        grado[primero]++;
+        grado[segundo]++;
+        for (int v = 0; v < N; v++)
+        {
+            cota -= 2 * penalizacion[v];
+        }
+
+        if (cota > mejorCota)
+        {
+            mejorCota = cota;
+            mejores = penalizacion;
+            sinMejora = 0;
+        }
+        else if (++sinMejora >= 5)
+        {
+            lambda /= 2;
+            sinMejora = 0;
+        }
+
+        // Subgradiente: grado - 2 de cada nodo
+        long long norma = 0;
+        for (int v = 0; v < N; v++)
+            norma += (long long)(grado[v] - 2) * (grado[v] - 2);
+        if (norma == 0)
+        {
+            break; // El 1-árbol ya es un recorrido: la cota es óptima
+        }
+        double paso = lambda * max(1LL, superior - cota) / norma;
+        for (int v = 0; v < N; v++)
+        {
+            int g = grado[v] - 2;
+            int cambio = (int)llround(paso * g);
+            if (cambio == 0 && g != 0)
+                cambio = g > 0 ? 1 : -1;
+            penalizacion[v] += cambio;
+        }
+        iteracion = chrono::steady_clock::now() - inicio;
+    }
+    penalizacion = mejores;
+    cotaRaiz = max(cotaRaiz, mejorCota);
+}
+
+/*
+***************************
+TSP - HEURÍSTICAS
+***************************
+*/
+// Listas de los k nodos más cercanos a cada nodo según d(i, j), en orden ascendente
+// Complejidad de tiempo: O(n^2 + n k log k)
+template <typename Distancia>
+vector<vector<int>> vecinosCercanos(int n, int k, Distancia d)
+{
+    k = max(0, min(k, n - 1));
+    vector<vector<int>> vecinos(n);
+    vector<int> candidatos;
+    for (int i = 0; i < n; i++)
+    {
+        auto compara = [&](int a, int b)
+        {
+            return d(i, a) < d(i, b) || (d(i, a) == d(i, b) && a < b);
+        };
+        candidatos.clear();
+        for (int j = 0; j < n; j++)
+            if (j != i)
+                candidatos.push_back(j);
+        nth_element(candidatos.begin(), candidatos.begin() + k, candidatos.end(), compara);
+        sort(candidatos.begin(), candidatos.begin() + k, compara);
+        vecinos[i].assign(candidatos.begin(), candidatos.begin() + k);
+    }
+    return vecinos;
+}
+
+// Recorrido del vecino más cercano desde el nodo 0. Con conReloj, si se agota el tiempo del modo anytime
+// los nodos que faltan se agregan en orden de índice.
+// Complejidad de tiempo: O(n^2)
+template <typename Distancia>
+vector<int> recorridoVecinoCercano(int n, Distancia d, bool conReloj = false)
+{
+    vector<int> ruta = {0};
+    vector<bool> usado(n, false);
+    usado[0] = true;
+    for (int paso = 1; paso < n; paso++)
+    {
+        if (conReloj && tiempoAgotado())
+        {
+            for (int v = 0; v < n; v++)
+                if (!usado[v])
+                    ruta.push_back(v);
+            break;
+        }
+        int actual = ruta.back(), siguiente = -1;
+        for (int v = 0; v < n; v++)
+            if (!usado[v] && (siguiente == -1 || d(actual, v) < d(actual, siguiente)))
+                siguiente = v;
+        usado[siguiente] = true;
+        ruta.push_back(siguiente);
+    }
+    return ruta;
+}
+
+// Recorrido del árbol doble: preorden del árbol de expansión mínima desde el nodo 0
+// (recorrer cada arista dos veces y saltarse los nodos repetidos)
+// Complejidad de tiempo: O(n)
+vector<int> recorridoArbolDoble(int n, const vector<Arista> &mst)
+{
+    vector<vector<int>> hijos(n);
+    for (const Arista &arista : mst)
+    {
+        hijos[arista.nodoA].push_back(arista.nodoB);
+        hijos[arista.nodoB].push_back(arista.nodoA);
+    }
+    vector<int> ruta, pila = {0};
+    vector<bool> usado(n, false);
+    while (!pila.empty())
+    {
+        int u = pila.back();
+        pila.pop_back();
+        if (usado[u])
+            continue;
+        usado[u] = true;
+        ruta.push_back(u);
+        for (auto it = hijos[u].rbegin(); it != hijos[u].rend(); ++it)
+            if (!usado[*it])
+                pila.push_back(*it);
+    }
+    return ruta;
+}
+
+// Costo del ciclo que sigue la ruta y regresa al primer nodo
+template <typename Distancia>
+long long costoRecorrido(const vector<int> &ruta, Distancia d)
+{
+    long long costo = 0;
+    for (size_t i = 0; i < ruta.size(); i++)
+        costo += d(ruta[i], ruta[(i + 1) % ruta.size()]);
+    return costo;
+}
+
+// Búsqueda local 2-opt + Or-opt con listas de vecinos y bits de "no mirar"
+// La ruta se guarda en un arreglo con la posición de cada nodo; cada movimiento Or-opt (mover un segmento
+// de 1 a 3 nodos entre otros dos) se arma con dos o tres movimientos 2-opt. d(i, j) debe ser simétrica;
+// cada movimiento aceptado baja el costo, así que la búsqueda termina.
+// Complejidad de tiempo: O(k) por nodo revisado más el costo de invertir segmentos, O(n) en el peor caso
+template <typename Distancia>
+void busquedaLocal(vector<int> &ruta, const vector<vector<int>> &vecinos, Distancia d)
+{
+    int n = ruta.size();
+    if (n < 8)
+    {
+        return;
+    }
+    vector<int> pos(n);
+    for (int i = 0; i < n; i++)
+        pos[ruta[i]] = i;
+    auto sig = [&](int v)
+    { return ruta[pos[v] + 1 == n ? 0 : pos[v] + 1]; };
+    auto ant = [&](int v)
+    { return ruta[pos[v] == 0 ? n - 1 : pos[v] - 1]; };
+
+    // Quita las aristas a-b y c-e (e = sig(c) si b = sig(a), o ambas en sentido contrario) y pone a-c y b-e
+    // Se invierte el lado más corto del ciclo
+    auto intercambio = [&](int a, int b, int c, int e)
+    {
+        int i = sig(a) == b ? pos[b] : pos[a];
+        int j = sig(a) == b ? pos[c] : pos[e];
+        int largo = (j - i + n) % n + 1;
+        if (2 * largo > n)
+        {
+            int ni = j + 1 == n ? 0 : j + 1;
+            j = i == 0 ? n - 1 : i - 1;
+            i = ni;
+            largo = n - largo;
+        }
+        for (int k = 0; k < largo / 2; k++)
+        {
+            swap(ruta[i], ruta[j]);
+            pos[ruta[i]] = i;
+            pos[ruta[j]] = j;
+            i = i + 1 == n ? 0 : i + 1;
+            j = j == 0 ? n - 1 : j - 1;
+        }
+    };
+
+    deque<int> cola(ruta.begin(), ruta.end());
+    vector<char> enCola(n, 1);
+    auto activar = [&](int v)
+    {
+        if (!enCola[v])
+        {
+            enCola[v] = 1;
+            cola.push_back(v);
+        }
+    };
+
+    for (long long iteracion = 1; !cola.empty(); iteracion++)
+    {
+        if (iteracion % 64 == 0 && tiempoAgotado())
+        {
+            break; // Modo anytime: se queda con la ruta mejorada hasta ahora
+        }
+        int a = cola.front();
+        cola.pop_front();
+        enCola[a] = 0;
+        bool mejoro = false;
+
+        // 2-opt: cambiar a-b y c-e por a-c y b-e, en ambos sentidos del recorrido
+        for (int sentido = 0; sentido < 2 && !mejoro; sentido++)
+        {
+            int b = sentido == 0 ? sig(a) : ant(a);
+            int dab = d(a, b);
+            for (int c : vecinos[a])
+            {
+                int dac = d(a, c);
+                if (dac >= dab)
+                    break;
+                int e = sentido == 0 ? sig(c) : ant(c);
+                if (c == b || e == a)
+                    continue;
+                if (dab + d(c, e) - dac - d(b, e) > 0)
+                {
+                    intercambio(a, b, c, e);
+                    activar(a), activar(b), activar(c), activar(e);
+                    mejoro = true;
+                    break;
+                }
+            }
+        }
+
+        // Or-opt: mover el segmento s1..se que empieza en a entre x y y = sig(x), derecho o invertido
+        for (int largo = 1; largo <= 3 && !mejoro; largo++)
+        {
+            int s1 = a, medio = largo == 3 ? sig(a) : a, se = a;
+            for (int k = 1; k < largo; k++)
+                se = sig(se);
+            int p = ant(s1), nx = sig(se);
+            auto enSegmento = [&](int v)
+            { return v == s1 || v == medio || v == se; };
+            int quitar = d(p, s1) + d(se, nx) - d(p, nx);
+            if (quitar <= 0)
+                continue;
+
+            for (int extremo = 0; extremo < 2 && !mejoro; extremo++)
+            {
+                int v = extremo == 0 ? s1 : se;
+                for (int c : vecinos[v])
+                {
+                    if (d(v, c) >= quitar || mejoro)
+                        break;
+                    for (int lado = 0; lado < 2; lado++)
+                    {
+                        int x = lado == 0 ? c : ant(c), y = lado == 0 ? sig(c) : c;
+                        if (enSegmento(x) || enSegmento(y) || y == p)
+                            continue;
+                        int invertido = d(x, se) + d(s1, y), directo = d(x, s1) + d(se, y);
+                        if (quitar - (min(invertido, directo) - d(x, y)) <= 0)
+                            continue;
+
+                        intercambio(p, s1, x, y); // p x..nx se..s1 y
+                        if (x != nx)
+                            intercambio(p, x, nx, se); // p nx..x se..s1 y
+                        if (directo < invertido)
+                            intercambio(x, se, s1, y); // p nx..x s1..se y
+                        activar(p), activar(nx), activar(s1), activar(se), activar(x), activar(y);
+                        mejoro = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (mejoro)
+        {
+            activar(a);
+        }
+    }
+}
+
+/**********
+Objetivo: Recorrido heurístico para el TSP sobre la matriz dist
+Entradas: Nada (usa dist y N); regresa el costo en el parámetro
+Salidas: El mejor recorrido (empezando en 0) de vecino más cercano y árbol doble, cada uno mejorado
+         con 2-opt + Or-opt sobre los 10 vecinos más cercanos de cada nodo. La búsqueda local usa
+         min(dist[i][j], dist[j][i]); el costo que se regresa es el real, en el mejor de los dos sentidos.
+Complejidad: O(n^2 log n) por la construcción y las listas de vecinos, más la búsqueda local. En modo
+             anytime el vecino más cercano va directo sobre dist, sin preparar nada, y revisa el reloj en
+             cada paso (si se agota, los nodos que faltan van en orden de índice, O(n)). Lo que tardó queda
+             en pasoCuadratico; si falta para la fecha límite menos de 4 veces eso, se regresa ese recorrido
+             sin mejorar en vez de armar la matriz simétrica, las listas o el árbol doble.
+***********/
+vector<int> recorridoHeuristico(long long &costo)
+{
+    costo = LLONG_MAX;
+    if (N == 0)
+    {
+        return {};
+    }
+    auto inicio = chrono::steady_clock::now();
+    auto real = [](int i, int j)
+    { return dist[i][j]; };
+    vector<int> mejor;
+    auto considerar = [&](vector<int> ruta)
+    {
+        rotate(ruta.begin(), find(ruta.begin(), ruta.end(), 0), ruta.end());
+        for (int sentido = 0; sentido < 2; sentido++)
+        {
+            long long c = costoRecorrido(ruta, real);
+            if (c < costo)
+            {
+                costo = c;
+                mejor = ruta;
+            }
+            reverse(ruta.begin() + 1, ruta.end());
+        }
+    };
+
+    vector<int> ruta = recorridoVecinoCercano(N, [](int i, int j)
+                                              { return min(dist[i][j], dist[j][i]); }, conFechaLimite);
+    // Cada etapa que sigue cuesta varias veces lo que el vecino más cercano
+    pasoCuadratico = chrono::steady_clock::now() - inicio;
+    auto etapa = 4 * pasoCuadratico;
+    if (quedaMenosDe(etapa))
+    {
+        considerar(ruta);
+        return mejor;
+    }
+
+    vector<int> simetrica((size_t)N * N);
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            simetrica[(size_t)i * N + j] = min(dist[i][j], dist[j][i]);
+    auto d = [&simetrica](int i, int j)
+    { return simetrica[(size_t)i * N + j]; };
+
+    vector<vector<int>> vecinos = vecinosCercanos(N, 10, d);
+    busquedaLocal(ruta, vecinos, d);
+    considerar(ruta);
+    if (quedaMenosDe(etapa))
+    {
+        return mejor;
+    }
+
+    ruta = recorridoArbolDoble(N, primDenso(N, simetrica));
+    busquedaLocal(ruta, vecinos, d);
+    considerar(ruta);
+    return mejor;
+}
+
+/*
+***************************
+TSP - CHRISTOFIDES
+***************************
+*/
+// Emparejamiento de peso máximo en un grafo general (algoritmo de Edmonds con variables duales y
+// contracción de flores). Los nodos van de 1 a n; los índices n+1..2n son las flores contraídas.
+// Una arista con peso 0 se considera ausente.
+// Complejidad de tiempo: O(n^3)
+// Complejidad de espacio: O(n^2)
+struct EmparejamientoMaximo
+{
+    struct AristaPesada
+    {
+        int u, v;
+        long long w;
+    };
+
+    int n, nx;
+    vector<vector<AristaPesada>> g;
+    vector<long long> etiqueta;                 // Variable dual de cada nodo y flor
+    vector<int> pareja, holgura, flor, padre, S; // S: -1 sin etiqueta, 0 par, 1 impar
+    vector<int> visto;
+    vector<vector<int>> florDesde; // florDesde[b][x]: hijo de la flor b que contiene al nodo x
+    vector<vector<int>> hijos;     // Ciclo de subflores de cada flor, empezando por la base
+    queue<int> cola;
+    int marca = 0;
+
+    EmparejamientoMaximo(int n)
+        : n(n), nx(n), g(2 * n + 1, vector<AristaPesada>(2 * n + 1)), etiqueta(2 * n + 1), pareja(2 * n + 1),
+          holgura(2 * n + 1), flor(2 * n + 1), padre(2 * n + 1), S(2 * n + 1), visto(2 * n + 1),
+          florDesde(2 * n + 1, vector<int>(n + 1)), hijos(2 * n + 1)
+    {
+        for (int u = 1; u <= 2 * n; ++u)
+            for (int v = 1; v <= 2 * n; ++v)
+                g[u][v] = {u, v, 0};
+    }
+
+    void agregar(int u, int v, long long w)
+    {
+        g[u][v].w = g[v][u].w = w;
+    }
+
+    long long reducido(const AristaPesada &e) const
+    {
+        return etiqueta[e.u] + etiqueta[e.v] - g[e.u][e.v].w * 2;
+    }
+
+    void actualizarHolgura(int u, int x)
+    {
+        if (!holgura[x] || reducido(g[u][x]) < reducido(g[holgura[x]][x]))
+            holgura[x] = u;
+    }
+
+    void calcularHolgura(int x)
+    {
+        holgura[x] = 0;
+        for (int u = 1; u <= n; ++u)
+            if (g[u][x].w > 0 && flor[u] != x && S[flor[u]] == 0)
+                actualizarHolgura(u, x);
+    }
+
+    void encolar(int x)
+    {
+        if (x <= n)
+            cola.push(x);
+        else
+            for (int y : hijos[x])
+                encolar(y);
+    }
+
+    void asignarFlor(int x, int b)
+    {
+        flor[x] = b;
+        if (x > n)
+            for (int y : hijos[x])
+                asignarFlor(y, b);
+    }
+
+    int posicionPar(int b, int xr)
+    {
+        int pr = find(hijos[b].begin(), hijos[b].end(), xr) - hijos[b].begin();
+        if (pr % 2 == 1)
+        {
+            reverse(hijos[b].begin() + 1, hijos[b].end());
+            return (int)hijos[b].size() - pr;
+        }
+        return pr;
+    }
+
+    void emparejar(int u, int v)
+    {
+        pareja[u] = g[u][v].v;
+        if (u > n)
+        {
+            AristaPesada e = g[u][v];
+            int xr = florDesde[u][e.u], pr = posicionPar(u, xr);
+            for (int i = 0; i < pr; ++i)
+                emparejar(hijos[u][i], hijos[u][i ^ 1]);
+            emparejar(xr, v);
+            rotate(hijos[u].begin(), hijos[u].begin() + pr, hijos[u].end());
+        }
+    }
+
+    void aumentar(int u, int v)
+    {
+        while (true)
+        {
+            int xnv = flor[pareja[u]];
+            emparejar(u, v);
+            if (!xnv)
+                return;
+            emparejar(xnv, flor[padre[xnv]]);
+            u = flor[padre[xnv]];
+            v = xnv;
+        }
+    }
+
+    int ancestroComun(int u, int v)
+    {
+        for (++marca; u || v; swap(u, v))
+        {
+            if (u == 0)
+                continue;
+            if (visto[u] == marca)
+                return u;
+            visto[u] = marca;
+            u = flor[pareja[u]];
+            if (u)
+                u = flor[padre[u]];
+        }
+        return 0;
+    }
+
+    void contraer(int u, int lca, int v)
+    {
+        int b = n + 1;
+        while (b <= nx && flor[b])
+            ++b;
+        if (b > nx)
+            ++nx;
+        etiqueta[b] = 0;
+        S[b] = 0;
+        pareja[b] = pareja[lca];
+        hijos[b] = {lca};
+        for (int x = u, y; x != lca; x = flor[padre[y]])
+        {
+            hijos[b].push_back(x);
+            hijos[b].push_back(y = flor[pareja[x]]);
+            encolar(y);
+        }
+        reverse(hijos[b].begin() + 1, hijos[b].end());
+        for (int x = v, y; x != lca; x = flor[padre[y]])
+        {
+            hijos[b].push_back(x);
+            hijos[b].push_back(y = flor[pareja[x]]);
+            encolar(y);
+        }
+        asignarFlor(b, b);
+        for (int x = 1; x <= nx; ++x)
+            g[b][x].w = g[x][b].w = 0;
+        for (int x = 1; x <= n; ++x)
+            florDesde[b][x] = 0;
+        for (int xs : hijos[b])
+        {
+            for (int x = 1; x <= nx; ++x)
+                if (g[b][x].w == 0 || reducido(g[xs][x]) < reducido(g[b][x]))
+                {
+                    g[b][x] = g[xs][x];
+                    g[x][b] = g[x][xs];
+                }
+            for (int x = 1; x <= n; ++x)
+                if (florDesde[xs][x])
+                    florDesde[b][x] = xs;
+        }
+        calcularHolgura(b);
+    }
+
+    void expandir(int b)
+    {
+        for (int y : hijos[b])
+            asignarFlor(y, y);
+        int xr = florDesde[b][g[b][padre[b]].u], pr = posicionPar(b, xr);
+        for (int i = 0; i < pr; i += 2)
+        {
+            int xs = hijos[b][i], xns = hijos[b][i + 1];
+            padre[xs] = g[xns][xs].u;
+            S[xs] = 1;
+            S[xns] = 0;
+            holgura[xs] = 0;
+            calcularHolgura(xns);
+            encolar(xns);
+        }
+        S[xr] = 1;
+        padre[xr] = padre[b];
+        for (size_t i = pr + 1; i < hijos[b].size(); ++i)
+        {
+            S[hijos[b][i]] = -1;
+            calcularHolgura(hijos[b][i]);
+        }
+        flor[b] = 0;
+    }
+
+    // Procesa una arista ajustada; regresa true si encontró un camino aumentante
+    bool aristaAjustada(const AristaPesada &e)
+    {
+        int u = flor[e.u], v = flor[e.v];
+        if (S[v] == -1)
+        {
+            padre[v] = e.u;
+            S[v] = 1;
+            int nu = flor[pareja[v]];
+            holgura[v] = holgura[nu] = 0;
+            S[nu] = 0;
+            encolar(nu);
+        }
+        else if (S[v] == 0)
+        {
+            int lca = ancestroComun(u, v);
+            if (!lca)
+            {
+                aumentar(u, v);
+                aumentar(v, u);
+                return true;
+            }
+            contraer(u, lca, v);
+        }
+        return false;
+    }
+
+    // Una fase: busca un camino aumentante ajustando las variables duales; false si ya no conviene
+    bool fase()
+    {
+        fill(S.begin() + 1, S.begin() + nx + 1, -1);
+        fill(holgura.begin() + 1, holgura.begin() + nx + 1, 0);
+        cola = queue<int>();
+        for (int x = 1; x <= nx; ++x)
+            if (flor[x] == x && !pareja[x])
+            {
+                padre[x] = 0;
+                S[x] = 0;
+                encolar(x);
+            }
+        if (cola.empty())
+            return false;
+        while (true)
+        {
+            while (!cola.empty())
+            {
+                int u = cola.front();
+                cola.pop();
+                if (S[flor[u]] == 1)
+                    continue;
+                for (int v = 1; v <= n; ++v)
+                    if (g[u][v].w > 0 && flor[u] != flor[v])
+                    {
+                        if (reducido(g[u][v]) == 0)
+                        {
+                            if (aristaAjustada(g[u][v]))
+                                return true;
+                        }
+                        else
+                            actualizarHolgura(u, flor[v]);
+                    }
+            }
+            long long d = LLONG_MAX;
+            for (int b = n + 1; b <= nx; ++b)
+                if (flor[b] == b && S[b] == 1)
+                    d = min(d, etiqueta[b] / 2);
+            for (int x = 1; x <= nx; ++x)
+                if (flor[x] == x && holgura[x])
+                {
+                    if (S[x] == -1)
+                        d = min(d, reducido(g[holgura[x]][x]));
+                    else if (S[x] == 0)
+                        d = min(d, reducido(g[holgura[x]][x]) / 2);
+                }
+            for (int u = 1; u <= n; ++u)
+            {
+                if (S[flor[u]] == 0)
+                {
+                    if (etiqueta[u] <= d)
+                        return false;
+                    etiqueta[u] -= d;
+                }
+                else if (S[flor[u]] == 1)
+                    etiqueta[u] += d;
+            }
+            for (int b = n + 1; b <= nx; ++b)
+                if (flor[b] == b)
+                {
+                    if (S[b] == 0)
+                        etiqueta[b] += d * 2;
+                    else if (S[b] == 1)
+                        etiqueta[b] -= d * 2;
+                }
+            cola = queue<int>();
+            for (int x = 1; x <= nx; ++x)
+                if (flor[x] == x && holgura[x] && flor[holgura[x]] != x && reducido(g[holgura[x]][x]) == 0)
+                    if (aristaAjustada(g[holgura[x]][x]))
+                        return true;
+            for (int b = n + 1; b <= nx; ++b)
+                if (flor[b] == b && S[b] == 1 && etiqueta[b] == 0)
+                    expandir(b);
+        }
+    }
+
+    // Calcula el emparejamiento; pareja[u] queda en 0 si u no se emparejó
+    void resolver()
+    {
+        long long maximo = 0;
+        for (int u = 0; u <= n; ++u)
+        {
+            flor[u] = u;
+            hijos[u].clear();
+            pareja[u] = 0;
+        }
+        for (int u = 1; u <= n; ++u)
+            for (int v = 1; v <= n; ++v)
+            {
+                florDesde[u][v] = u == v ? u : 0;
+                maximo = max(maximo, g[u][v].w);
+            }
+        for (int u = 1; u <= n; ++u)
+            etiqueta[u] = maximo;
+        while (fase())
+        {
+        }
+    }
+};
+
+string emparejamientoTSP = "auto";   // --emparejamiento=auto|exacto|voraz
+const int MAX_IMPARES_EXACTO = 400; // Arriba de estos vértices impares "auto" usa el emparejamiento voraz
+
+/**********
+Objetivo: Emparejamiento perfecto de peso mínimo de los vértices impares
+Entradas: Los vértices (una cantidad par) y la distancia d(i, j)
+Salidas: Los pares. Con pesos M - d(i, j), donde M es mayor que cualquier emparejamiento perfecto,
+         el de peso máximo es perfecto y entre los perfectos es el de menor distancia.
+Complejidad: O(k^3) donde k es el número de vértices
+***********/
+template <typename Distancia>
+vector<pair<int, int>> emparejamientoExacto(const vector<int> &vertices, Distancia d)
+{
+    int k = vertices.size();
+    long long maximo = 0;
+    for (int a = 0; a < k; ++a)
+        for (int b = a + 1; b < k; ++b)
+            maximo = max(maximo, (long long)d(vertices[a], vertices[b]));
+    long long M = maximo * (k / 2 + 1) + 1;
+
+    EmparejamientoMaximo emparejamiento(k);
+    for (int a = 0; a < k; ++a)
+        for (int b = a + 1; b < k; ++b)
+            emparejamiento.agregar(a + 1, b + 1, M - d(vertices[a], vertices[b]));
+    emparejamiento.resolver();
+
+    vector<pair<int, int>> pares;
+    for (int a = 1; a <= k; ++a)
+        if (emparejamiento.pareja[a] > a)
+            pares.push_back({vertices[a - 1], vertices[emparejamiento.pareja[a] - 1]});
+    return pares;
+}
+
+/**********
+Objetivo: Emparejamiento perfecto voraz de los vértices impares
+Entradas: Los vértices (una cantidad par) y candidatas(restantes), que da aristas candidatas entre los
+          vértices que faltan
+Salidas: Los pares: se recorren las candidatas de menor a mayor peso y se toma cada una cuyos dos
+         extremos estén libres. Si quedan vértices sin pareja se piden candidatas solo entre ellos y se
+         repite; si una ronda no empareja a nadie, los que quedan se emparejan en el orden en que están.
+Complejidad: O(c log c) por ronda, donde c es el número de candidatas
+***********/
+template <typename Candidatas>
+vector<pair<int, int>> emparejamientoVoraz(vector<int> restantes, Candidatas candidatas)
+{
+    vector<pair<int, int>> pares;
+    vector<bool> libre;
+    while (!restantes.empty())
+    {
+        vector<Arista> aristas = candidatas(restantes);
+        sort(aristas.begin(), aristas.end(), comparaAristas);
+        int maximo = *max_element(restantes.begin(), restantes.end());
+        libre.assign(maximo + 1, false);
+        for (int v : restantes)
+            libre[v] = true;
+
+        size_t antes = pares.size();
+        for (const Arista &arista : aristas)
+        {
+            if (arista.nodoA != arista.nodoB && libre[arista.nodoA] && libre[arista.nodoB])
+            {
+                libre[arista.nodoA] = libre[arista.nodoB] = false;
+                pares.push_back({arista.nodoA, arista.nodoB});
+            }
+        }
+        vector<int> faltan;
+        for (int v : restantes)
+            if (libre[v])
+                faltan.push_back(v);
+        if (pares.size() == antes)
+        {
+            for (size_t i = 0; i + 1 < faltan.size(); i += 2)
+                pares.push_back({faltan[i], faltan[i + 1]});
+            break;
+        }
+        restantes = move(faltan);
+    }
+    return pares;
+}
+
+/**********
+Objetivo: Ciclo hamiltoniano a partir de un multigrafo con todos los grados pares
+Entradas: El número de nodos y las aristas del multigrafo (conexo)
+Salidas: El recorrido euleriano desde el nodo 0 (algoritmo de Hierholzer) con los nodos repetidos
+         omitidos; con la desigualdad del triángulo cada atajo no aumenta el costo.
+Complejidad: O(n + m) donde m es el número de aristas
+***********/
+vector<int> atajarRecorridoEuleriano(int n, const vector<pair<int, int>> &aristas)
+{
+    // Listas de adyacencia planas: inicio[u] .. inicio[u + 1] en ady, con el índice de cada arista
+    vector<int> inicio(n + 1, 0), ady(2 * aristas.size()), usadaPor(2 * aristas.size());
+    for (const auto &arista : aristas)
+    {
+        inicio[arista.first + 1]++;
+        inicio[arista.second + 1]++;
+    }
+    partial_sum(inicio.begin(), inicio.end(), inicio.begin());
+    vector<int> siguiente(inicio.begin(), inicio.end() - 1);
+    for (size_t e = 0; e < aristas.size(); ++e)
+    {
+        usadaPor[siguiente[aristas[e].first]] = e;
+        ady[siguiente[aristas[e].first]++] = aristas[e].second;
+        usadaPor[siguiente[aristas[e].second]] = e;
+        ady[siguiente[aristas[e].second]++] = aristas[e].first;
+    }
+
+    vector<bool> usada(aristas.size(), false), visitado(n, false);
+    vector<int> puntero(inicio.begin(), inicio.end() - 1), pila = {0}, ruta;
+    ruta.reserve(n);
+    while (!pila.empty())
+    {
+        int u = pila.back();
+        while (puntero[u] < inicio[u + 1] && usada[usadaPor[puntero[u]]])
+            puntero[u]++;
+        if (puntero[u] == inicio[u + 1])
+        {
+            // u sale del recorrido euleriano (en orden inverso); solo se guarda su primera aparición
+            pila.pop_back();
+            if (!visitado[u])
+            {
+                visitado[u] = true;
+                ruta.push_back(u);
+            }
+        }
+        else
+        {
+            usada[usadaPor[puntero[u]]] = true;
+            pila.push_back(ady[puntero[u]]);
+        }
+    }
+    reverse(ruta.begin(), ruta.end());
+    rotate(ruta.begin(), find(ruta.begin(), ruta.end(), 0), ruta.end());
+    return ruta;
+}
+
+/**********
+Objetivo: Recorrido de Christofides
+Entradas: El número de nodos, su árbol de expansión mínima, la distancia d(i, j) (simétrica) y
+          candidatas(vertices) para el emparejamiento voraz
+Salidas: El recorrido desde el nodo 0: MST + emparejamiento perfecto de sus vértices de grado impar,
+         recorrido euleriano y atajos. Con el emparejamiento exacto y d métrica cuesta a lo más 1.5
+         veces el óptimo. emparejamientoTSP elige el exacto o el voraz ("auto": exacto con hasta
+         MAX_IMPARES_EXACTO vértices impares).
+Complejidad: O(n log n) más el emparejamiento: O(k^3) exacto o el de las candidatas voraz, donde k
+             es el número de vértices impares
+***********/
+template <typename Distancia, typename Candidatas>
+vector<int> christofides(int n, const vector<Arista> &mst, Distancia d, Candidatas candidatas)
+{
+    if (n <= 2)
+    {
+        vector<int> ruta(n);
+        iota(ruta.begin(), ruta.end(), 0);
+        return ruta;
+    }
+    vector<int> grado(n, 0);
+    vector<pair<int, int>> multigrafo;
+    for (const Arista &arista : mst)
+    {
+        grado[arista.nodoA]++;
+        grado[arista.nodoB]++;
+        multigrafo.push_back({arista.nodoA, arista.nodoB});
+    }
+    vector<int> impares;
+    for (int v = 0; v < n; ++v)
+        if (grado[v] % 2 == 1)
+            impares.push_back(v);
+
+    bool exacto = emparejamientoTSP == "exacto" || (emparejamientoTSP == "auto" && (int)impares.size() <= MAX_IMPARES_EXACTO);
+    vector<pair<int, int>> pares = exacto ? emparejamientoExacto(impares, d) : emparejamientoVoraz(impares, candidatas);
+    multigrafo.insert(multigrafo.end(), pares.begin(), pares.end());
+    return atajarRecorridoEuleriano(n, multigrafo);
+}
+
+/**********
+Objetivo: Recorrido de Christofides sobre la matriz dist
+Entradas: Nada (usa dist y N); regresa el costo en el parámetro
+Salidas: El recorrido (empezando en 0) en el mejor de los dos sentidos. El MST es kruskal() sobre
+         min(dist[i][j], dist[j][i]) y las candidatas del emparejamiento voraz son todos los pares.
+Complejidad: O(n^2 log n) por kruskal() más el emparejamiento
+***********/
+vector<int> recorridoChristofides(long long &costo)
+{
+    auto d = [](int i, int j)
+    { return min(dist[i][j], dist[j][i]); };
+    vector<Arista> aristas;
+    for (int i = 0; i < N; ++i)
+        for (int j = i + 1; j < N; ++j)
+            aristas.emplace_back(i, j, d(i, j));
+    vector<Arista> mst = kruskal(N, move(aristas));
+
+    auto todosLosPares = [&d](const vector<int> &vertices)
+    {
+        vector<Arista> candidatas;
+        for (size_t a = 0; a < vertices.size(); ++a)
+            for (size_t b = a + 1; b < vertices.size(); ++b)
+                candidatas.emplace_back(vertices[a], vertices[b], d(vertices[a], vertices[b]));
+        return candidatas;
+    };
+    vector<int> ruta = christofides(N, mst, d, todosLosPares);
+
+    auto real = [](int i, int j)
+    { return dist[i][j]; };
+    costo = costoRecorrido(ruta, real);
+    reverse(ruta.begin() + 1, ruta.end());
+    long long alReves = costoRecorrido(ruta, real);
+    if (alReves < costo)
+        costo = alReves;
+    else
+        reverse(ruta.begin() + 1, ruta.end());
+    return ruta;
+}
+
+/**********
+Objetivo: Recorrido de Christofides a partir de las coordenadas, sin matriz de distancias
+Entradas: Las centrales, su MST euclidiano (el de mstDelaunay()) y el costo (salida)
+Salidas: El recorrido desde el nodo 0. Las candidatas del emparejamiento voraz son las aristas de la
+         triangulación de Delaunay de los vértices que faltan: la arista más corta entre ellos siempre
+         está ahí, así que cada ronda empareja al menos un par.
+Complejidad: O(n log n) en la práctica con el emparejamiento voraz
+***********/
+vector<int> recorridoChristofidesCoordenadas(const vector<pair<int, int>> &centrales, const vector<Arista> &mst, long long &costo)
+{
+    auto d = [&centrales](int i, int j)
+    { return pesoEuclidiano(centrales[i], centrales[j]); };
+    auto delaunayEntre = [&centrales](const vector<int> &vertices)
+    {
+        vector<pair<int, int>> puntos;
+        for (int v : vertices)
+            puntos.push_back(centrales[v]);
+        vector<Arista> candidatas = aristasDelaunay(puntos);
+        for (Arista &arista : candidatas)
+        {
+            arista.nodoA = vertices[arista.nodoA];
+            arista.nodoB = vertices[arista.nodoB];
+        }
+        return candidatas;
+    };
+    vector<int> ruta = christofides(centrales.size(), mst, d, delaunayEntre);
+    costo = costoRecorrido(ruta, d);
+    return ruta;
+}
+
+/*
+Algoritmo de voronoi --------------------------------
+*/
+/**********
+Objetivo: Marcar en 'conservar' los vértices que Ramer-Douglas-Peucker conserva del tramo [inicio, fin) de puntos
+          (fin puede valer puntos.size() + 1: el índice puntos.size() es el vértice 0, para cerrar un polígono).
+          Es iterativo con una pila explícita de rangos de índices: no copia puntos ni depende de la profundidad
+          de la recursión. Las distancias se comparan al cuadrado, sin sqrt: el punto más lejano de la recta es el
+          de mayor |a x + b y - c| y se separa si (a x + b y - c)^2 > epsilon^2 (a^2 + b^2).
+Entradas: Los puntos, el tramo, epsilon y el mapa de bits de vértices conservados
+Salidas: Nada, marca los extremos del tramo y los vértices que lo dividen
+Complejidad: O(n log n) en promedio y O(n^2) en el peor caso, con n = fin - inicio; memoria O(log n) a O(n) de pila
+***********/
+void marcarRDP(const vector<pair<int, int>> &puntos, size_t inicio, size_t fin, double epsilon, vector<char> &conservar)
+{
+    size_t n = puntos.size();
+    long double epsilon2 = (long double)epsilon * epsilon;
+    vector<pair<size_t, size_t>> pila = {{inicio, fin - 1}}; // Extremos incluidos de cada tramo pendiente
+    while (!pila.empty())
+    {
+        auto [primero, ultimo] = pila.back();
+        pila.pop_back();
+        const pair<int, int> &p = puntos[primero % n], &q = puntos[ultimo % n];
+        long long a = (long long)q.second - p.second, b = (long long)p.first - q.first;
+        long long c = a * p.first + b * p.second;
+        size_t maxI = primero;
+        long long maxNumerador = 0;
+        for (size_t i = primero + 1; i < ultimo; ++i) // ultimo <= n: solo los extremos pueden dar la vuelta
+        {
+            long long numerador = llabs(a * puntos[i].first + b * puntos[i].second - c);
+            if (numerador > maxNumerador)
+            {
+                maxI = i;
+                maxNumerador = numerador;
+            }
+        }
+        if ((long double)maxNumerador * maxNumerador > epsilon2 * (long double)(a * a + b * b))
+        {
+            // Se procesa primero la mitad izquierda; el orden no cambia el resultado
+            pila.push_back({maxI, ultimo});
+            pila.push_back({primero, maxI});
+        }
+        else
+        {
+            conservar[primero % n] = conservar[ultimo % n] = 1;
+        }
+    }
+}
+
+// Ramer-Douglas-Peucker de una cadena abierta: conserva el primer y el último punto
+void ramerDouglasPeucker(const vector<pair<int, int>> &puntos, double epsilon, vector<pair<int, int>> &resultado)
+{
+    if (puntos.size() < 2)
+    {
+        return;
+    }
+    vector<char> conservar(puntos.size(), 0);
+    marcarRDP(puntos, 0, puntos.size(), epsilon, conservar);
+    for (size_t i = 0; i < puntos.size(); ++i)
+    {
+        if (conservar[i])
+        {
+            resultado.push_back(puntos[i]);
+        }
+    }
+}
+
+/**********
+Objetivo: Ramer-Douglas-Peucker de un polígono cerrado (sin repetir el primer vértice al final). Se parte en dos
+          cadenas por el vértice 0 y el más lejano a él, que se conservan siempre; la segunda da la vuelta
+Entradas: Los vértices del polígono en orden y epsilon
+Salidas: Los vértices conservados, en el mismo orden
+Complejidad: La de marcarRDP(), O(n log n) en promedio
+***********/
+void ramerDouglasPeuckerCerrado(const vector<pair<int, int>> &puntos, double epsilon, vector<pair<int, int>> &resultado)
+{
+    size_t n = puntos.size();
+    if (n < 3)
+    {
+        resultado.insert(resultado.end(), puntos.begin(), puntos.end());
+        return;
+    }
+    size_t lejano = 0;
+    long long maxDistancia = -1;
+    for (size_t i = 1; i < n; ++i)
+    {
+        long long dx = (long long)puntos[i].first - puntos[0].first, dy = (long long)puntos[i].second - puntos[0].second;
+        if (dx * dx + dy * dy > maxDistancia)
+        {
+            maxDistancia = dx * dx + dy * dy;
+            lejano = i;
+        }
+    }
+    vector<char> conservar(n, 0);
+    marcarRDP(puntos, 0, lejano + 1, epsilon, conservar);
+    marcarRDP(puntos, lejano, n + 1, epsilon, conservar);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (conservar[i])
+        {
+            resultado.push_back(puntos[i]);
+        }
+    }
+}
+
+double distancia(int x1, int y1, int x2, int y2)
+{
+    int dx = x2 - x1;
+    int dy = y2 - y1;
+    return sqrt(dx * dx + dy * dy);
+}
+
+// Función para encontrar la central más cercana dado un punto (x, y)
+int centralMasCercana(int x, int y, const vector<pair<int, int>> &centrales)
+{
+    double minDist = 1e9;
+    int idx = -1;
+    for (int i = 0; i < centrales.size(); ++i)
+    {
+        double dist = distancia(x, y, centrales[i].first, centrales[i].second);
+        if (dist < minDist)
+        {
+            minDist = dist;
+            idx = i;
+        }
+    }
+    return idx;
+}
+
+/**********
+Objetivo: Índice estático (árbol k-d en 2D) para encontrar la central más cercana a un punto, por ejemplo al
+          asignar las direcciones de los clientes a su central o al etiquetar la malla de Voronoi
+Entradas: Las centrales, una sola vez en el constructor
+Salidas: masCercana(x, y) da el mismo índice que centralMasCercana() (empates: el menor índice);
+         masCercanas() resuelve un lote de puntos, repartido entre 'hilos' hilos
+Complejidad: Construcción O(N log N); consulta O(log N) esperado. El árbol es implícito, sin apuntadores: el
+             nodo del rango [inicio, fin) está en (inicio + fin) / 2 y sus hijos son las dos mitades.
+***********/
+class ArbolKD
+{
+    vector<int> px, py, indice; // Centrales reordenadas: la raíz de cada rango en su posición media
+    vector<char> eje;           // Coordenada que divide cada nodo: 0 = x, 1 = y
+
+    void construir(int inicio, int fin)
+    {
+        if (fin - inicio <= 1)
+        {
+            if (fin > inicio)
+                eje[inicio] = 0;
+            return;
+        }
+        // Se divide por la coordenada con mayor extensión
+        int xmin = INT_MAX, xmax = INT_MIN, ymin = INT_MAX, ymax = INT_MIN;
+        for (int i = inicio; i < fin; ++i)
+        {
+            xmin = min(xmin, px[indice[i]]), xmax = max(xmax, px[indice[i]]);
+            ymin = min(ymin, py[indice[i]]), ymax = max(ymax, py[indice[i]]);
+        }
+        int medio = (inicio + fin) / 2;
+        char e = (long long)ymax - ymin > (long long)xmax - xmin;
+        const vector<int> &coordenada = e ? py : px;
+        nth_element(indice.begin() + inicio, indice.begin() + medio, indice.begin() + fin, [&coordenada](int a, int b)
+                    { return coordenada[a] < coordenada[b]; });
+        eje[medio] = e;
+        construir(inicio, medio);
+        construir(medio + 1, fin);
+    }
+
+public:
+    ArbolKD(const vector<pair<int, int>> &centrales) : px(centrales.size()), py(centrales.size()), indice(centrales.size()), eje(centrales.size())
+    {
+        for (size_t i = 0; i < centrales.size(); ++i)
+        {
+            px[i] = centrales[i].first;
+            py[i] = centrales[i].second;
+        }
+        iota(indice.begin(), indice.end(), 0);
+        construir(0, indice.size());
+        // Las coordenadas quedan en el orden del árbol para recorrerlo sin indirecciones
+        vector<int> x(indice.size()), y(indice.size());
+        for (size_t i = 0; i < indice.size(); ++i)
+        {
+            x[i] = px[indice[i]];
+            y[i] = py[indice[i]];
+        }
+        px.swap(x);
+        py.swap(y);
+    }
+
+    int masCercana(int x, int y) const
+    {
+        struct Pendiente
+        {
+            int inicio, fin;
+            long long cota; // Distancia al cuadrado mínima posible dentro del rango
+        } pila[128];
+        int tope = 0;
+        pila[tope++] = {0, (int)indice.size(), 0};
+        long long mejor = LLONG_MAX;
+        int central = -1;
+        while (tope > 0)
+        {
+            Pendiente p = pila[--tope];
+            // Con cota igual a la mejor distancia todavía puede haber un empate con menor índice
+            if (p.inicio >= p.fin || p.cota > mejor)
+            {
+                continue;
+            }
+            int medio = (p.inicio + p.fin) / 2;
+            long long dx = (long long)x - px[medio], dy = (long long)y - py[medio];
+            long long d = dx * dx + dy * dy;
+            if (d < mejor || (d == mejor && indice[medio] < central))
+            {
+                mejor = d;
+                central = indice[medio];
+            }
+            long long diferencia = eje[medio] ? dy : dx;
+            // Primero el lado del punto (queda arriba de la pila), luego el otro si la cota lo permite
+            if (diferencia < 0)
+            {
+                pila[tope++] = {medio + 1, p.fin, diferencia * diferencia};
+                pila[tope++] = {p.inicio, medio, 0};
+            }
+            else
+            {
+                pila[tope++] = {p.inicio, medio, diferencia * diferencia};
+                pila[tope++] = {medio + 1, p.fin, 0};
+            }
+        }
+        return central;
+    }
+
+    // Las k centrales más cercanas a (x, y) ordenadas por (distancia, índice); con k >= N regresa todas
+    vector<int> kMasCercanas(int x, int y, int k) const
+    {
+        k = min<int>(k, indice.size());
+        vector<pair<long long, int>> mejores; // Montículo de máximos con las k mejores hasta ahora
+        if (k <= 0)
+        {
+            return {};
+        }
+        struct Pendiente
+        {
+            int inicio, fin;
+            long long cota;
+        } pila[128];
+        int tope = 0;
+        pila[tope++] = {0, (int)indice.size(), 0};
+        while (tope > 0)
+        {
+            Pendiente p = pila[--tope];
+            if (p.inicio >= p.fin || ((int)mejores.size() == k && p.cota > mejores.front().first))
+            {
+                continue;
+            }
+            int medio = (p.inicio + p.fin) / 2;
+            long long dx = (long long)x - px[medio], dy = (long long)y - py[medio];
+            pair<long long, int> candidato = {dx * dx + dy * dy, indice[medio]};
+            if ((int)mejores.size() < k)
+            {
+                mejores.push_back(candidato);
+                push_heap(mejores.begin(), mejores.end());
+            }
+            else if (candidato < mejores.front())
+            {
+                pop_heap(mejores.begin(), mejores.end());
+                mejores.back() = candidato;
+                push_heap(mejores.begin(), mejores.end());
+            }
+            long long diferencia = eje[medio] ? dy : dx;
+            if (diferencia < 0)
+            {
+                pila[tope++] = {medio + 1, p.fin, diferencia * diferencia};
+                pila[tope++] = {p.inicio, medio, 0};
+            }
+            else
+            {
+                pila[tope++] = {p.inicio, medio, diferencia * diferencia};
+                pila[tope++] = {medio + 1, p.fin, 0};
+            }
+        }
+        sort_heap(mejores.begin(), mejores.end());
+        vector<int> resultado;
+        for (const auto &mejor : mejores)
+        {
+            resultado.push_back(mejor.second);
+        }
+        return resultado;
+    }
+
+    // Consulta en lote: resultado[i] = masCercana(puntos[i])
+    void masCercanas(const pair<int, int> *puntos, size_t n, int *resultado, int hilos = 1) const
+    {
+        paraleloEnBloques(n, hilos, [&](size_t inicio, size_t fin, int)
+                          {
+            for (size_t i = inicio; i < fin; ++i)
+            {
+                resultado[i] = masCercana(puntos[i].first, puntos[i].second);
+            } });
+    }
+
+    vector<int> masCercanas(const vector<pair<int, int>> &puntos, int hilos = 1) const
+    {
+        vector<int> resultado(puntos.size());
+        masCercanas(puntos.data(), puntos.size(), resultado.data(), hilos);
+        return resultado;
+    }
+};
+
+// Coordenadas de las centrales como estructura de arreglos para los kernels vectoriales. Se rellenan hasta un
+// múltiplo de 16 repitiendo la última central: el relleno empata con ella y tiene mayor índice, así que nunca gana.
+// Las distancias al cuadrado se calculan en 32 bits, por eso el área no debe medir más de MAX_LADO_SOA por lado.
+struct CentralesSoA
+{
+    static const int MAX_LADO_SOA = 32767; // 2 * 32767^2 < 2^31
+    vector<int> x, y;
+
+    CentralesSoA(const vector<pair<int, int>> &centrales)
+    {
+        size_t relleno = (centrales.size() + 15) / 16 * 16;
+        for (size_t i = 0; i < relleno; ++i)
+        {
+            const pair<int, int> &central = centrales[min(i, centrales.size() - 1)];
+            x.push_back(central.first);
+            y.push_back(central.second);
+        }
+    }
+};
+
+// Etiqueta los puntos (x, y0 + b * paso), b < cuantos, de una columna de la malla con su central más cercana,
+// igual que centralMasCercana(). En una columna dx^2 de cada central es constante y se calcula una sola vez; por
+// punto solo queda dy^2 + dx^2 y el mínimo por carril con su índice. Versión escalar, AVX2 (8 centrales por
+// instrucción) y AVX-512 (16); elegirEtiquetadoSoA() escoge según el procesador y --simd=.
+using EtiquetadoSoA = void (*)(const CentralesSoA &centrales, int x, int y0, int paso, int cuantos, int *etiqueta);
+
+void etiquetarSoAEscalar(const CentralesSoA &centrales, int x, int y0, int paso, int cuantos, int *etiqueta)
+{
+    int n = centrales.x.size();
+    vector<int> dx2(n);
+    for (int j = 0; j < n; ++j)
+    {
+        dx2[j] = (x - centrales.x[j]) * (x - centrales.x[j]);
+    }
+    for (int b = 0; b < cuantos; ++b)
+    {
+        int y = y0 + b * paso, mejor = INT_MAX, central = -1;
+        for (int j = 0; j < n; ++j)
+        {
+            int d = dx2[j] + (y - centrales.y[j]) * (y - centrales.y[j]);
+            if (d < mejor)
             {
-                camino[pos] = i;
-                visitado[i] = true;
+                mejor = d;
+                central = j;
+            }
+        }
+        etiqueta[b] = central;
+    }
+}
 
-                TSP(pos + 1);
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) void etiquetarSoAAVX2(const CentralesSoA &centrales, int x, int y0, int paso, int cuantos, int *etiqueta)
+{
+    int n = centrales.x.size();
+    vector<int> dx2(n);
+    for (int j = 0; j < n; ++j)
+    {
+        dx2[j] = (x - centrales.x[j]) * (x - centrales.x[j]);
+    }
+    const int *cy = centrales.y.data();
+    for (int b = 0; b < cuantos; ++b)
+    {
+        __m256i y = _mm256_set1_epi32(y0 + b * paso);
+        __m256i mejor = _mm256_set1_epi32(INT_MAX), indice = _mm256_setzero_si256();
+        __m256i j8 = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        for (int j = 0; j < n; j += 8)
+        {
+            __m256i dy = _mm256_sub_epi32(y, _mm256_loadu_si256((const __m256i *)(cy + j)));
+            __m256i d = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(dx2.data() + j)), _mm256_mullo_epi32(dy, dy));
+            __m256i menor = _mm256_cmpgt_epi32(mejor, d); // Estricto: en cada carril gana el primer índice
+            mejor = _mm256_min_epi32(mejor, d);
+            indice = _mm256_blendv_epi8(indice, j8, menor);
+            j8 = _mm256_add_epi32(j8, _mm256_set1_epi32(8));
+        }
+        alignas(32) int d[8], k[8];
+        _mm256_store_si256((__m256i *)d, mejor);
+        _mm256_store_si256((__m256i *)k, indice);
+        int central = k[0];
+        for (int l = 1; l < 8; ++l)
+        {
+            if (d[l] < d[0] || (d[l] == d[0] && k[l] < central))
+            {
+                d[0] = d[l];
+                central = k[l];
+            }
+        }
+        etiqueta[b] = central;
+    }
+}
 
-                visitado[i] = false; // para que se vuelva a considerar en el siguiente camino
+__attribute__((target("avx512f"))) void etiquetarSoAAVX512(const CentralesSoA &centrales, int x, int y0, int paso, int cuantos, int *etiqueta)
+{
+    int n = centrales.x.size();
+    vector<int> dx2(n);
+    for (int j = 0; j < n; ++j)
+    {
+        dx2[j] = (x - centrales.x[j]) * (x - centrales.x[j]);
+    }
+    const int *cy = centrales.y.data();
+    for (int b = 0; b < cuantos; ++b)
+    {
+        __m512i y = _mm512_set1_epi32(y0 + b * paso);
+        __m512i mejor = _mm512_set1_epi32(INT_MAX), indice = _mm512_setzero_si512();
+        __m512i j16 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        for (int j = 0; j < n; j += 16)
+        {
+            __m512i dy = _mm512_sub_epi32(y, _mm512_loadu_si512(cy + j));
+            __m512i d = _mm512_add_epi32(_mm512_loadu_si512(dx2.data() + j), _mm512_mullo_epi32(dy, dy));
+            __mmask16 menor = _mm512_cmplt_epi32_mask(d, mejor);
+            mejor = _mm512_mask_mov_epi32(mejor, menor, d);
+            indice = _mm512_mask_mov_epi32(indice, menor, j16);
+            j16 = _mm512_add_epi32(j16, _mm512_set1_epi32(16));
+        }
+        // Entre los carriles con la distancia mínima, el menor índice; a mano como en la versión AVX2, porque
+        // _mm512_reduce_min_epi32 y _mm512_mask_reduce_min_epi32 dejan avisos -Wuninitialized en g++ 12
+        alignas(64) int d[16], k[16];
+        _mm512_store_si512(d, mejor);
+        _mm512_store_si512(k, indice);
+        int central = k[0];
+        for (int l = 1; l < 16; ++l)
+        {
+            if (d[l] < d[0] || (d[l] == d[0] && k[l] < central))
+            {
+                d[0] = d[l];
+                central = k[l];
             }
         }
+        etiqueta[b] = central;
     }
 }
+#endif
 
-/*
-***************************
-***************************
-TRAVELLING SALESMAN PROBLEM - END
-***************************
-***************************
-*/
-
-// Estructura para representar una arista con sus respectivos nodos y peso
-struct Arista
+/**********
+Objetivo: Elegir la versión del etiquetado de columnas según el procesador y --simd=
+Entradas: Nada (usa simdTSP)
+Salidas: La función más rápida disponible
+Complejidad: O(1)
+***********/
+EtiquetadoSoA elegirEtiquetadoSoA()
 {
-    int nodoA, nodoB, peso;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && (simdTSP == "auto" || simdTSP == "avx512"))
+        return etiquetarSoAAVX512;
+    if (__builtin_cpu_supports("avx2") && simdTSP != "escalar")
+        return etiquetarSoAAVX2;
+#endif
+    return etiquetarSoAEscalar;
+}
 
-    Arista(int a, int b, int w) : nodoA(a), nodoB(b), peso(w) {}
-};
+const int MAX_CENTRALES_SIMD = 64; // Con "auto", hasta cuántas centrales se usa el kernel vectorial
+string motorVoronoi = "auto"; // Etiquetado de la malla: --voronoi=auto|edt|kd|simd|fuerza
 
-// Función para comparar aristas, utilizada para ordenar las aristas según su peso
-bool comparaAristas(const Arista &a, const Arista &b)
+// Fracción num / den (den > 0) de las fronteras de la envolvente inferior; den = 0 representa +-infinito
+struct Frontera
 {
-    return a.peso < b.peso;
-}
+    long long num, den;
+};
 
-// Función que encuentra el padre de un nodo en un conjunto disjunto
-// Complejidad de tiempo: O(log N), donde N es el número de nodos
-// Complejidad de espacio: O(1), ya que no usa espacio adicional
-int encontrarPadre(vector<int> &padre, int nodo)
+// a < b, con ±infinito (den = 0, signo en num)
+inline bool fronteraMenor(const Frontera &a, const Frontera &b)
 {
-    if (padre[nodo] == nodo)
-        return nodo;
-    return padre[nodo] = encontrarPadre(padre, padre[nodo]);
+    if (a.den == 0 || b.den == 0)
+    {
+        return (a.den == 0 ? a.num : 0) < (b.den == 0 ? b.num : 0);
+    }
+    return (__int128)a.num * b.den < (__int128)b.num * a.den;
 }
 
-// Función para unir dos conjuntos en un conjunto disjunto
-// Complejidad de tiempo: O(log N), donde N es el número de nodos
-// Complejidad de espacio: O(1), ya que no usa espacio adicional
-void unirConjuntos(vector<int> &padre, int nodoA, int nodoB)
+// Índice de la transformada de distancia: las centrales agrupadas por columna x y, dentro de cada columna, por
+// (y, índice). Se construye una sola vez y lo comparten todas las bandas de filas.
+struct ColumnasEDT
 {
-    int padreA = encontrarPadre(padre, nodoA);
-    int padreB = encontrarPadre(padre, nodoB);
-    padre[padreA] = padreB;
-}
+    vector<int> orden;         // Centrales en orden (x, y, índice)
+    vector<int> inicioColumna; // Columna c: orden[inicioColumna[c] .. inicioColumna[c + 1])
+    vector<int> columnaX;      // x de cada columna, relativa a xmin
+    vector<int> inicioGrupo;   // Primera posición con la misma (x, y): la de menor índice
 
-// Algoritmo de Kruskal
-// Complejidad de tiempo: O(E * log(E)), donde E es el número de aristas
-// Complejidad de espacio: O(V + E), donde V es el número de nodos
-vector<Arista> kruskal(int N, vector<Arista> aristas)
-{
-    int numNodos = N;
-    vector<int> padre(N);
-    vector<Arista> mst; // Árbol de expansión mínima
+    ColumnasEDT(const vector<pair<int, int>> &centrales, int xmin) : orden(centrales.size()), inicioGrupo(centrales.size())
+    {
+        int n = centrales.size();
+        iota(orden.begin(), orden.end(), 0);
+        sort(orden.begin(), orden.end(), [&centrales](int a, int b)
+             { return make_pair(centrales[a], a) < make_pair(centrales[b], b); });
+        for (int p = 0; p < n; ++p)
+        {
+            const pair<int, int> &central = centrales[orden[p]];
+            if (p == 0 || central.first != centrales[orden[p - 1]].first)
+            {
+                inicioColumna.push_back(p);
+                columnaX.push_back(central.first - xmin);
+            }
+            inicioGrupo[p] = (p > 0 && central == centrales[orden[p - 1]]) ? inicioGrupo[p - 1] : p;
+        }
+        inicioColumna.push_back(n);
+    }
+};
 
-    // Inicializar conjunto disjunto
-    for (int i = 0; i < N; ++i)
+/**********
+Objetivo: Etiquetar cada punto muestreado (xmin + a * incremento, ymin + b * incremento) del rectángulo con
+          su central más cercana, igual que centralMasCercana() pero sin recorrer todas las centrales por punto.
+          Es la transformada de distancia euclidiana separable (Felzenszwalb-Huttenlocher) con etiquetas:
+          d^2 = min sobre columnas c de (x - c)^2 + g_c(y), donde g_c(y) es la distancia vertical al cuadrado a
+          la central más cercana de la columna c. Por fila se calcula g_c con un puntero por columna y luego la
+          envolvente inferior de las parábolas (x - c)^2 + g_c. Los empates se rompen por el menor índice,
+          comparando (d^2, índice) en lugar de sqrt(d^2), así que la etiqueta coincide con la de la fuerza bruta.
+Entradas: El índice por columnas, las centrales, el rectángulo, el paso de la malla, f(x, y, central), que se llama con cada punto
+          muestreado, fila por fila (y ascendente) y en cada fila con x ascendente, y opcionalmente el rango
+          [filaInicio, filaFin) de filas de la malla a etiquetar (para repartir bandas de filas entre hilos)
+Salidas: Nada, las etiquetas se entregan a f
+Complejidad: O(filas * min(N, xmax - xmin + 1) + puntos), independiente de N para N grande, más O(N log N)
+             de construir el índice
+***********/
+template <typename F>
+void etiquetarVoronoiEDT(const ColumnasEDT &indice, const vector<pair<int, int>> &centrales, int xmin, int ymin, int xmax, int ymax,
+                         int incremento, F f, int filaInicio = 0, int filaFin = INT_MAX)
+{
+    const vector<int> &orden = indice.orden, &inicioColumna = indice.inicioColumna;
+    const vector<int> &columnaX = indice.columnaX, &inicioGrupo = indice.inicioGrupo;
+    int columnas = columnaX.size();
+    if (columnas == 0)
     {
-        padre[i] = i;
+        return;
     }
 
-    // Ordenar aristas por peso
-    sort(aristas.begin(), aristas.end(), comparaAristas);
+    // Primera central de cada columna con y >= la primera fila de la banda
+    long long yInicio = (long long)filaInicio * incremento;
+    vector<int> puntero(columnas);
+    for (int c = 0; c < columnas; ++c)
+    {
+        puntero[c] = partition_point(orden.begin() + inicioColumna[c], orden.begin() + inicioColumna[c + 1], [&](int central)
+                                     { return centrales[central].second - ymin < yInicio; }) -
+                     orden.begin();
+    }
+    vector<long long> g(columnas);
+    vector<int> etiqueta(columnas);
+    vector<int> envolvente(columnas); // Columnas de la envolvente inferior, de izquierda a derecha
+    vector<Frontera> z(columnas + 1); // z[k]: frontera izquierda del tramo k de la envolvente
 
-    for (Arista &arista : aristas)
+    for (long long y = yInicio; y <= ymax - ymin && y < (long long)filaFin * incremento; y += incremento)
     {
-        int nodoA = arista.nodoA;
-        int nodoB = arista.nodoB;
+        // g_c(y) y la central que lo da en cada columna
+        for (int c = 0; c < columnas; ++c)
+        {
+            int &p = puntero[c];
+            while (p < inicioColumna[c + 1] && centrales[orden[p]].second - ymin < y)
+            {
+                ++p;
+            }
+            long long mejor = LLONG_MAX;
+            if (p < inicioColumna[c + 1])
+            {
+                mejor = centrales[orden[p]].second - ymin - y;
+                etiqueta[c] = orden[p];
+            }
+            if (p > inicioColumna[c])
+            {
+                int q = inicioGrupo[p - 1];
+                long long d = y - (centrales[orden[q]].second - ymin);
+                if (d < mejor || (d == mejor && orden[q] < etiqueta[c]))
+                {
+                    mejor = d;
+                    etiqueta[c] = orden[q];
+                }
+            }
+            g[c] = mejor * mejor;
+        }
 
-        // Verificar que los nodos no estén ya conectados
-        if (encontrarPadre(padre, nodoA) != encontrarPadre(padre, nodoB))
+        // Envolvente inferior de las parábolas; las que solo empatan en un punto se conservan (tramo vacío)
+        // para que el desempate por índice vea a todas
+        auto interseccion = [&](int u, int v)
         {
-            mst.push_back(arista);
-            unirConjuntos(padre, nodoA, nodoB);
-            numNodos--;
+            long long cu = columnaX[u], cv = columnaX[v];
+            return Frontera{(g[v] + cv * cv) - (g[u] + cu * cu), 2 * (cv - cu)};
+        };
+        int k = 0;
+        envolvente[0] = 0;
+        z[0] = {-1, 0};
+        z[1] = {1, 0};
+        for (int c = 1; c < columnas; ++c)
+        {
+            Frontera s = interseccion(envolvente[k], c);
+            while (k > 0 && fronteraMenor(s, z[k]))
+            {
+                --k;
+                s = interseccion(envolvente[k], c);
+            }
+            ++k;
+            envolvente[k] = c;
+            z[k] = s;
+            z[k + 1] = {1, 0};
+        }
+        int tramos = k + 1;
 
-            // Todas las colonias conectadas
-            if (numNodos == 1)
+        // Evaluación en los puntos de la fila
+        k = 0;
+        for (int x = 0; x <= xmax - xmin; x += incremento)
+        {
+            Frontera punto{x, 1};
+            while (k + 1 < tramos && fronteraMenor(z[k + 1], punto))
             {
-                break;
+                ++k;
+            }
+            long long mejor = LLONG_MAX;
+            int central = -1;
+            for (int j = k; j < tramos && (j == k || !fronteraMenor(punto, z[j])); ++j)
+            {
+                int c = envolvente[j];
+                long long dx = x - columnaX[c];
+                long long d = dx * dx + g[c];
+                if (d < mejor || (d == mejor && etiqueta[c] < central))
+                {
+                    mejor = d;
+                    central = etiqueta[c];
+                }
             }
+            f(x + xmin, y + ymin, central);
         }
     }
+}
 
-    return mst;
+// Toda la malla de una vez, construyendo el índice por columnas
+template <typename F>
+void etiquetarVoronoiEDT(const vector<pair<int, int>> &centrales, int xmin, int ymin, int xmax, int ymax, int incremento, F f)
+{
+    etiquetarVoronoiEDT(ColumnasEDT(centrales, xmin), centrales, xmin, ymin, xmax, ymax, incremento, f);
 }
 
-/*
-Algoritmo de voronoi --------------------------------
-*/
-double puntoLineaDist(const pair<int, int> &punto, const pair<int, int> &inicio, const pair<int, int> &fin)
+int pasoVoronoi = 10; // Separación entre puntos muestreados de la malla (--paso-voronoi=); ajustable según el área
+
+// Malla de etiquetas de Voronoi: solo los puntos muestreados (xmin + a * paso, ymin + b * paso), en un único
+// arreglo contiguo por columnas (a mayor). Ocupa paso^2 veces menos que una malla de resolución completa.
+struct MallaVoronoi
 {
-    double a = (double)fin.second - inicio.second;
-    double b = (double)inicio.first - fin.first;
-    double c = (double)a * inicio.first + b * inicio.second;
+    int xmin, ymin, paso, columnas, filas;
+    vector<int> etiqueta;
 
-    double dist = abs(a * punto.first + b * punto.second - c) / sqrt(a * a + b * b);
+    MallaVoronoi(int xmin, int ymin, int xmax, int ymax, int paso)
+        : xmin(xmin), ymin(ymin), paso(paso), columnas((xmax - xmin) / paso + 1), filas((ymax - ymin) / paso + 1),
+          etiqueta((size_t)columnas * filas, -1) {}
 
-    return dist;
-}
+    int &en(int a, int b) { return etiqueta[(size_t)a * filas + b]; }
+    int x(int a) const { return xmin + a * paso; }
+    int y(int b) const { return ymin + b * paso; }
+};
 
-void ramerDouglasPeucker(const vector<pair<int, int>> &puntos, double epsilon, vector<pair<int, int>> &resultado)
+string contornoVoronoi = "frontera"; // Puntos de cada polígono: --contorno=frontera (muestras de frontera) o muestras
+
+/**********
+Objetivo: Envolvente convexa por cadena monótona (Andrew)
+Entradas: Puntos ordenados por (x, y)
+Salidas: Los vértices de la envolvente en sentido antihorario, desde el menor (x, y) y sin puntos colineales
+Complejidad: O(n) con los puntos ya ordenados
+***********/
+vector<pair<int, int>> envolventeConvexa(const vector<pair<int, int>> &puntos)
 {
-    if (puntos.size() < 2)
+    if (puntos.size() < 3)
     {
-        return;
+        return puntos;
     }
+    auto giro = [](const pair<int, int> &o, const pair<int, int> &a, const pair<int, int> &b)
+    {
+        return (long long)(a.first - o.first) * (b.second - o.second) - (long long)(a.second - o.second) * (b.first - o.first);
+    };
+    vector<pair<int, int>> envolvente(2 * puntos.size());
+    size_t k = 0;
+    for (size_t i = 0; i < puntos.size(); ++i) // Cadena inferior
+    {
+        while (k >= 2 && giro(envolvente[k - 2], envolvente[k - 1], puntos[i]) <= 0)
+            --k;
+        envolvente[k++] = puntos[i];
+    }
+    for (size_t i = puntos.size() - 1, inferior = k + 1; i-- > 0;) // Cadena superior
+    {
+        while (k >= inferior && giro(envolvente[k - 2], envolvente[k - 1], puntos[i]) <= 0)
+            --k;
+        envolvente[k++] = puntos[i];
+    }
+    envolvente.resize(k - 1); // El último es el primero otra vez
+    return envolvente;
+}
 
-    auto maxI = 0;
-    double maxDist = 0.0;
+string celdasVoronoi = "malla"; // Polígonos de Voronoi: --celdas=malla (muestreo y RDP) o exactas (recorte)
 
-    for (auto i = 1; i < puntos.size() - 1; ++i)
+/**********
+Objetivo: Calcular la celda de Voronoi exacta de una central, recortando el rectángulo con los semiplanos
+          de las mediatrices con sus vecinas. Las vecinas se piden al árbol k-d de la más cercana a la más lejana
+          (primero 16, luego el doble...) y se deja de recortar cuando la siguiente está a más del doble de la
+          distancia al vértice más lejano de la celda: su mediatriz ya no la toca.
+Entradas: El índice de la central, las centrales, su árbol k-d y el rectángulo
+Salidas: Los vértices del polígono convexo en sentido antihorario, sin repetidos (un punto o un segmento si el
+         rectángulo es degenerado); vacío si la central está repetida y otra central igual tiene menor índice
+         (como en la malla, la celda es de la de menor índice)
+Complejidad: O(k log N + k * v) por celda, donde k son las vecinas revisadas y v los vértices (k es O(1)
+             en promedio para centrales distribuidas uniformemente)
+***********/
+vector<pair<double, double>> celdaExacta(int c, const vector<pair<int, int>> &centrales, const ArbolKD &arbol,
+                                         int xmin, int ymin, int xmax, int ymax)
+{
+    vector<pair<double, double>> celda = {{xmin, ymin}, {xmax, ymin}, {xmax, ymax}, {xmin, ymax}}, recortada;
+    double cx = centrales[c].first, cy = centrales[c].second;
+    int n = centrales.size();
+    size_t revisadas = 1; // La primera vecina es la central misma (o una igual)
+    for (int k = min(16, n);; k = min(2 * k, n))
     {
-        double dist = puntoLineaDist(puntos[i], puntos.front(), puntos.back());
-        if (dist > maxDist)
+        vector<int> vecinas = arbol.kMasCercanas(centrales[c].first, centrales[c].second, k);
+        for (; revisadas < vecinas.size() && !celda.empty(); ++revisadas)
         {
-            maxI = i;
-            maxDist = dist;
+            int q = vecinas[revisadas] == c ? vecinas[0] : vecinas[revisadas];
+            double nx = centrales[q].first - cx, ny = centrales[q].second - cy;
+            if (nx == 0 && ny == 0)
+            {
+                if (q < c)
+                {
+                    celda.clear(); // Central repetida: la celda es de la igual con menor índice
+                }
+                continue;
+            }
+            // Semiplano de los puntos p más cercanos a c que a q: n . p <= (|q|^2 - |c|^2) / 2
+            double limite = (nx * (centrales[q].first + cx) + ny * (centrales[q].second + cy)) / 2;
+            recortada.clear();
+            for (size_t i = 0; i < celda.size(); ++i)
+            {
+                const pair<double, double> &a = celda[i], &b = celda[(i + 1) % celda.size()];
+                double da = nx * a.first + ny * a.second - limite, db = nx * b.first + ny * b.second - limite;
+                if (da <= 0)
+                {
+                    recortada.push_back(a);
+                }
+                if ((da < 0 && db > 0) || (da > 0 && db < 0))
+                {
+                    double t = da / (da - db);
+                    recortada.push_back({a.first + t * (b.first - a.first), a.second + t * (b.second - a.second)});
+                }
+            }
+            celda.swap(recortada);
+        }
+        if (celda.empty() || k == n)
+        {
+            break;
+        }
+        // Las vecinas que faltan están al menos a la distancia de la última revisada
+        double radio = 0;
+        for (const auto &vertice : celda)
+        {
+            radio = max(radio, (vertice.first - cx) * (vertice.first - cx) + (vertice.second - cy) * (vertice.second - cy));
+        }
+        const pair<int, int> &ultima = centrales[vecinas.back()];
+        double distancia = (ultima.first - cx) * (ultima.first - cx) + (ultima.second - cy) * (ultima.second - cy);
+        if (distancia >= 4 * radio)
+        {
+            break;
         }
     }
-
-    if (maxDist > epsilon)
-    {
-        vector<pair<int, int>> antes(maxI + 1);
-        copy(puntos.begin(), puntos.begin() + maxI + 1, antes.begin());
-        vector<pair<int, int>> despues(puntos.size() - maxI);
-        copy(puntos.begin() + maxI, puntos.end(), despues.begin());
-
-        ramerDouglasPeucker(antes, epsilon, resultado);
-        resultado.pop_back();
-        ramerDouglasPeucker(despues, epsilon, resultado);
-    }
-    else
+    // Con un rectángulo degenerado (una sola central, o todas en una recta horizontal o vertical) el recorte
+    // deja vértices repetidos: se quitan para dar un punto o un segmento
+    celda.erase(unique(celda.begin(), celda.end()), celda.end());
+    while (celda.size() > 1 && celda.back() == celda.front())
     {
-        resultado.push_back(puntos.front());
-        resultado.push_back(puntos.back());
+        celda.pop_back();
     }
-}
-double distancia(int x1, int y1, int x2, int y2)
-{
-    int dx = x2 - x1;
-    int dy = y2 - y1;
-    return sqrt(dx * dx + dy * dy);
+    return celda;
 }
 
-// Función para encontrar la central más cercana dado un punto (x, y)
-int centralMasCercana(int x, int y, const vector<pair<int, int>> &centrales)
+/**********
+Objetivo: Imprimir las celdas de Voronoi exactas de todas las centrales, en el mismo orden y formato que
+          voronoi() (vértices con dos decimales)
+Entradas: Las centrales y el rectángulo que las encierra
+Salidas: Nada, imprime -4 y cada polígono precedido de -4i
+Complejidad: O(N log N) en promedio; ni el tiempo ni la memoria dependen del tamaño del área. Las celdas se
+             calculan en paralelo por bloques, cada uno en su búfer, y los búferes se imprimen en orden.
+***********/
+void voronoiExacto(const vector<pair<int, int>> &centrales, int xmin, int ymin, int xmax, int ymax)
 {
-    double minDist = 1e9;
-    int idx = -1;
-    for (int i = 0; i < centrales.size(); ++i)
-    {
-        double dist = distancia(x, y, centrales[i].first, centrales[i].second);
-        if (dist < minDist)
+    int n = centrales.size();
+    ArbolKD arbol(centrales);
+    vector<int> indice(n);
+    iota(indice.begin(), indice.end(), 0);
+    sort(indice.begin(), indice.end(), [&centrales](int i, int j)
+         { return centrales[i].first < centrales[j].first; });
+
+    const int POLIGONOS_BLOQUE = 64;
+    vector<string> salida((n + POLIGONOS_BLOQUE - 1) / POLIGONOS_BLOQUE);
+    ejecutarConRobo(salida.size(), numHilos, [&](size_t bloque, int)
+                    {
+        ostringstream bufer;
+        bufer << fixed << setprecision(2);
+        int fin = min(n, (int)(bloque + 1) * POLIGONOS_BLOQUE);
+        for (int i = bloque * POLIGONOS_BLOQUE; i < fin; ++i)
         {
-            minDist = dist;
-            idx = i;
+            bufer << -4 << i + 1 << '\n';
+            for (const auto &vertice : celdaExacta(indice[i], centrales, arbol, xmin, ymin, xmax, ymax))
+            {
+                bufer << vertice.first << " " << vertice.second << '\n';
+            }
         }
+        salida[bloque] = bufer.str(); });
+
+    cout << -4 << endl;
+    for (const string &bufer : salida)
+    {
+        cout << bufer;
     }
-    return idx;
+    cout.flush();
 }
 
 // Función para generar e imprimir los polígonos de Voronoi que cumplan con los requisitos
 void voronoi(const vector<pair<int, int>> &centrales, int xmin, int ymin, int xmax, int ymax)
 {
+    if (celdasVoronoi == "exactas")
+    {
+        voronoiExacto(centrales, xmin, ymin, xmax, ymax);
+        return;
+    }
 
-    // Generar la malla con las coordenadas x e y del rectángulo delimitado
-    vector<vector<int>> malla(xmax - xmin + 1, vector<int>(ymax - ymin + 1, -1));
-
-    int incremento = 10; // Puedes ajustar este valor según el tamaño del área
+    // Generar la malla con los puntos muestreados del rectángulo delimitado
+    MallaVoronoi malla(xmin, ymin, xmax, ymax, pasoVoronoi);
 
-    for (int x = xmin; x <= xmax; x += incremento)
+    // La transformada de distancia cuesta por fila O(columnas con centrales + puntos) y el árbol k-d O(puntos log N):
+    // con muchas más columnas ocupadas que puntos por fila conviene el árbol
+    // Con pocas centrales gana la comparación vectorial contra todas, O(puntos * N / 16)
+    string motor = motorVoronoi;
+    bool cabeSoA = (long long)xmax - xmin <= CentralesSoA::MAX_LADO_SOA && (long long)ymax - ymin <= CentralesSoA::MAX_LADO_SOA;
+    if (motor == "auto")
     {
-        for (int y = ymin; y <= ymax; y += incremento)
-        {
-            malla[x - xmin][y - ymin] = centralMasCercana(x, y, centrales);
-        }
+        motor = min<long long>(centrales.size(), xmax - xmin + 1) > 8LL * malla.columnas ? "kd"
+                : centrales.size() <= MAX_CENTRALES_SIMD && cabeSoA                    ? "simd"
+                                                                                        : "edt";
     }
-
-    // Generar polígonos de Voronoi para cada central según la malla
-    vector<vector<pair<int, int>>> poligonos(centrales.size());
-    for (int x = 0; x < malla.size(); ++x)
+    else if (motor == "simd" && !cabeSoA)
     {
-        for (int y = 0; y < malla[0].size(); ++y)
+        motor = "kd";
+    }
+
+    // Etiquetar la malla por teselas de TESELA x TESELA puntos (la transformada de distancia, por bandas de TESELA
+    // filas completas) con robo de trabajo; cada tesela escribe en una parte distinta de la malla
+    const int TESELA = 64;
+    int teselasX = (malla.columnas + TESELA - 1) / TESELA, teselasY = (malla.filas + TESELA - 1) / TESELA;
+    CentralesSoA soa(motor == "simd" ? centrales : vector<pair<int, int>>{});
+    EtiquetadoSoA etiquetar = elegirEtiquetadoSoA();
+    unique_ptr<ArbolKD> arbol(motor == "kd" ? new ArbolKD(centrales) : nullptr);
+    unique_ptr<ColumnasEDT> columnasEDT(motor == "edt" ? new ColumnasEDT(centrales, xmin) : nullptr);
+    ejecutarConRobo(motor == "edt" ? teselasY : (size_t)teselasX * teselasY, numHilos, [&](size_t tesela, int)
+                    {
+        int b0 = tesela % teselasY * TESELA, b1 = min(malla.filas, b0 + TESELA);
+        if (motor == "edt")
         {
-            int central_idx = malla[x][y];
-            poligonos[central_idx].push_back({x + xmin, y + ymin});
+            etiquetarVoronoiEDT(*columnasEDT, centrales, xmin, ymin, xmax, ymax, malla.paso, [&](int x, int y, int central)
+                                { malla.en((x - xmin) / malla.paso, (y - ymin) / malla.paso) = central; }, b0, b1);
+            return;
         }
-    }
-    vector<vector<pair<int, int>>> poligonosFiltrados(centrales.size());
+        int a0 = tesela / teselasY * TESELA, a1 = min(malla.columnas, a0 + TESELA);
+        vector<pair<int, int>> puntos(b1 - b0);
+        for (int a = a0; a < a1; ++a)
+        {
+            if (motor == "simd")
+            {
+                etiquetar(soa, malla.x(a), malla.y(b0), malla.paso, b1 - b0, &malla.en(a, b0));
+            }
+            else if (motor == "kd")
+            {
+                // Un lote de consultas por columna de la tesela, que se escribe directo en su tramo del arreglo
+                for (int b = b0; b < b1; ++b)
+                {
+                    puntos[b - b0] = {malla.x(a), malla.y(b)};
+                }
+                arbol->masCercanas(puntos.data(), puntos.size(), &malla.en(a, b0));
+            }
+            else
+            {
+                for (int b = b0; b < b1; ++b)
+                {
+                    malla.en(a, b) = centralMasCercana(malla.x(a), malla.y(b), centrales);
+                }
+            }
+        } });
 
-    for (int i = 0; i < poligonos.size(); ++i)
+    // Con --contorno=frontera solo se guardan las muestras de la frontera de cada celda (vecindad de 8): las
+    // muestras con alguna de sus 8 vecinas de otra celda, más las del borde del rectángulo. No se traza el
+    // contorno; la envolvente convexa es la misma que la de todas las muestras de la celda, pero con
+    // O(perímetro) puntos en lugar de O(área).
+    bool soloFrontera = contornoVoronoi == "frontera";
+    auto guardar = [&](int a, int b)
     {
-        for (const auto &punto : poligonos[i])
+        if (!soloFrontera || a == 0 || b == 0 || a == malla.columnas - 1 || b == malla.filas - 1)
+        {
+            return true;
+        }
+        int etiqueta = malla.en(a, b);
+        for (int da = -1; da <= 1; ++da)
         {
-            if (punto.first >= xmin && punto.first <= xmax && punto.second >= ymin && punto.second <= ymax)
+            for (int db = -1; db <= 1; ++db)
             {
-                poligonosFiltrados[i].push_back(punto);
+                if (malla.en(a + da, b + db) != etiqueta)
+                {
+                    return true;
+                }
             }
         }
+        return false;
+    };
+
+    // Generar polígonos de Voronoi para cada central según la malla: los puntos de la central c quedan en
+    // puntosPoligono[inicioPoligono[c] .. inicioPoligono[c + 1]), en el mismo orden que el recorrido secuencial
+    // por columnas. Cada hilo cuenta y luego copia los de su bloque de columnas; los bloques se acomodan en orden.
+    int n = centrales.size(), hilos = max(1, min(numHilos, malla.columnas));
+    vector<vector<size_t>> cuenta(hilos, vector<size_t>(n, 0));
+    paraleloEnBloques(malla.columnas, hilos, [&](size_t inicio, size_t fin, int h)
+                      {
+        for (size_t a = inicio; a < fin; ++a)
+            for (int b = 0; b < malla.filas; ++b)
+                if (guardar(a, b))
+                    cuenta[h][malla.en(a, b)]++; });
+    vector<size_t> inicioPoligono(n + 1, 0);
+    for (int c = 0; c < n; ++c)
+    {
+        size_t posicion = inicioPoligono[c];
+        for (int h = 0; h < hilos; ++h)
+        {
+            size_t puntosBloque = cuenta[h][c];
+            cuenta[h][c] = posicion; // Desde aquí escribe el bloque h los puntos de c
+            posicion += puntosBloque;
+        }
+        inicioPoligono[c + 1] = posicion;
     }
+    vector<pair<int, int>> puntosPoligono(inicioPoligono[n]);
+    paraleloEnBloques(malla.columnas, hilos, [&](size_t inicio, size_t fin, int h)
+                      {
+        for (size_t a = inicio; a < fin; ++a)
+            for (int b = 0; b < malla.filas; ++b)
+                if (guardar(a, b))
+                    puntosPoligono[cuenta[h][malla.en(a, b)]++] = {malla.x(a), malla.y(b)}; });
 
     // Imprimir los polígonos de Voronoi, en el orden ascendente de la menor coordenada x de cada polígono
-    cout << -4 << endl;
-    for (int i = 0; i < poligonosFiltrados.size(); ++i)
+    auto comparaCentrales = [&centrales](int i, int j)
     {
-        auto comparaCentrales = [&centrales](int i, int j)
+        return centrales[i].first < centrales[j].first;
+    };
+    vector<int> indice(centrales.size());
+    iota(indice.begin(), indice.end(), 0);
+    sort(indice.begin(), indice.end(), comparaCentrales);
+
+    // Cada bloque de POLIGONOS_BLOQUE polígonos se ordena, simplifica y escribe en su propio búfer en paralelo;
+    // los búferes se imprimen en orden, así la salida es idéntica a la secuencial
+    const int POLIGONOS_BLOQUE = 64;
+    vector<string> salida((n + POLIGONOS_BLOQUE - 1) / POLIGONOS_BLOQUE);
+    ejecutarConRobo(salida.size(), numHilos, [&](size_t bloque, int)
+                    {
+        ostringstream bufer;
+        int fin = min(n, (int)(bloque + 1) * POLIGONOS_BLOQUE);
+        for (int i = bloque * POLIGONOS_BLOQUE; i < fin; ++i)
         {
-            return centrales[i].first < centrales[j].first;
-        };
-        vector<int> indice(centrales.size());
-        iota(indice.begin(), indice.end(), 0);
-        sort(indice.begin(), indice.end(), comparaCentrales);
+            int central_idx = indice[i];
+            vector<pair<int, int>> poligono(puntosPoligono.begin() + inicioPoligono[central_idx],
+                                            puntosPoligono.begin() + inicioPoligono[central_idx + 1]);
+
+            if (soloFrontera)
+            {
+                // Los puntos ya vienen ordenados por (x, y), como los pide la cadena monótona
+                poligono = envolventeConvexa(poligono);
+            }
+            else
+            {
+                // Ordenar puntos del polígono en sentido horario
+                auto puntoCentral = centrales[central_idx];
+                // Orden estricto por ángulo alrededor de la central, en sentido antihorario desde el eje x positivo:
+                // primero el semiplano (la central misma, luego ángulos en [0, pi), luego [pi, 2 pi)), después
+                // el producto cruz y en empate (misma dirección) la distancia. Solo el producto cruz no es un orden
+                // débil estricto y sort() con él es comportamiento indefinido.
+                auto semiplano = [](long long dx, long long dy)
+                {
+                    return dx == 0 && dy == 0 ? 0 : (dy > 0 || (dy == 0 && dx > 0)) ? 1 : 2;
+                };
+                auto comparaPuntos = [&puntoCentral, &semiplano](pair<int, int> a, pair<int, int> b)
+                {
+                    long long axdiff = a.first - puntoCentral.first;
+                    long long aydiff = a.second - puntoCentral.second;
+                    long long bxdiff = b.first - puntoCentral.first;
+                    long long bydiff = b.second - puntoCentral.second;
 
-        int central_idx = indice[i];
+                    int sa = semiplano(axdiff, aydiff), sb = semiplano(bxdiff, bydiff);
+                    if (sa != sb)
+                    {
+                        return sa < sb;
+                    }
+                    long long cruz = axdiff * bydiff - aydiff * bxdiff;
+                    if (cruz != 0)
+                    {
+                        return cruz > 0;
+                    }
+                    return axdiff * axdiff + aydiff * aydiff < bxdiff * bxdiff + bydiff * bydiff;
+                };
 
-        // Ordenar puntos del polígono en sentido horario
-        auto puntoCentral = centrales[central_idx];
-        auto comparaPuntos = [&puntoCentral](pair<int, int> a, pair<int, int> b)
-        {
-            int axdiff = a.first - puntoCentral.first;
-            int aydiff = a.second - puntoCentral.second;
-            int bxdiff = b.first - puntoCentral.first;
-            int bydiff = b.second - puntoCentral.second;
+                sort(poligono.begin(), poligono.end(), comparaPuntos);
+            }
 
-            if (axdiff * bydiff - aydiff * bxdiff > 0)
+            // Imprimir polígono de Voronoi
+            double epsilon = 30.0; // El valor de epsilon se puede ajustar según la cantidad de simplificación deseada
+            vector<pair<int, int>> poligonoSimplificado;
+            if (soloFrontera)
             {
-                return true;
+                ramerDouglasPeuckerCerrado(poligono, epsilon, poligonoSimplificado);
             }
             else
             {
-                return false;
+                ramerDouglasPeucker(poligono, epsilon, poligonoSimplificado);
             }
-        };
 
-        sort(poligonosFiltrados[central_idx].begin(), poligonosFiltrados[central_idx].end(), comparaPuntos);
+            // Imprimir polígono de Voronoi simplificado
+            bufer << -4 << i + 1 << '\n';
+            for (const auto &punto : poligonoSimplificado)
+            {
+                bufer << punto.first << " " << punto.second << '\n';
+            }
+        }
+        salida[bloque] = bufer.str(); });
+
+    cout << -4 << endl;
+    for (const string &bufer : salida)
+    {
+        cout << bufer;
+    }
+    cout.flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Regresa el valor de una opción "--nombre=valor" de la línea de comandos, o el valor por defecto
+string opcion(int argc, char *argv[], const string &nombre, const string &porDefecto)
+{
+    string prefijo = "--" + nombre + "=";
+    for (int a = 1; a < argc; ++a)
+    {
+        string arg = argv[a];
+        if (arg.compare(0, prefijo.size(), prefijo) == 0)
+        {
+            return arg.substr(prefijo.size());
+        }
+    }
+    return porDefecto;
+}
 
-        // Imprimir polígono de Voronoi
-        double epsilon = 30.0; // El valor de epsilon se puede ajustar según la cantidad de simplificación deseada
-        vector<pair<int, int>> poligonoSimplificado;
-        ramerDouglasPeucker(poligonosFiltrados[central_idx], epsilon, poligonoSimplificado);
+bool opcionesValidas = true; // Se apaga si alguna opción con valores fijos trae uno desconocido
 
-        // Imprimir polígono de Voronoi simplificado
-        cout << -4 << i + 1 << endl;
-        for (const auto &punto : poligonoSimplificado)
+// Como opcion(), pero el valor debe ser uno de 'valores'; si no, lo reporta en la salida de error y apaga
+// opcionesValidas (main() termina con código 1 después de leer todas las opciones)
+string opcionDe(int argc, char *argv[], const string &nombre, const string &porDefecto, const vector<string> &valores)
+{
+    string valor = opcion(argc, argv, nombre, porDefecto);
+    if (find(valores.begin(), valores.end(), valor) == valores.end())
+    {
+        cerr << "valor desconocido para --" << nombre << ": " << valor << " (se espera ";
+        for (size_t k = 0; k < valores.size(); ++k)
         {
-            cout << punto.first << " " << punto.second << endl;
+            cerr << (k == 0 ? "" : k + 1 == valores.size() ? " o " : ", ") << valores[k];
         }
+        cerr << ")" << endl;
+        opcionesValidas = false;
     }
+    return valor;
 }
 
-// ------------------------------------------------------------------------------------------------
-int main()
+#ifndef SIN_MAIN
+int main(int argc, char *argv[])
 {
+    // Motor del árbol de expansión mínima: --mst=auto|prim|kruskal|filtro|boruvka|delaunay
+    string motorMST = opcionDe(argc, argv, "mst", "auto", {"auto", "prim", "kruskal", "filtro", "boruvka", "delaunay"});
+    // Formato de entrada: "matriz" (N, matriz, coordenadas, matriz) o "coordenadas" (N y coordenadas;
+    // las distancias son las euclidianas redondeadas y el MST se calcula con Delaunay)
+    bool soloCoordenadas = opcionDe(argc, argv, "entrada", "matriz", {"matriz", "coordenadas"}) == "coordenadas";
+    if (soloCoordenadas)
+    {
+        motorMST = "delaunay";
+    }
+    numHilos = max(1, stoi(opcion(argc, argv, "hilos", to_string(numHilos))));
+    // Motor del TSP: --tsp=auto|bb|heldkarp|heuristico|christofides, y memoria máxima para Held-Karp (y la
+    // búsqueda mejor primero) en MB. "auto" siempre es exacto; para N grande conviene --tsp=heuristico o
+    // --tiempo-ms
+    string motorTSP = opcionDe(argc, argv, "tsp", "auto", {"auto", "bb", "heldkarp", "heuristico", "christofides"});
+    // Emparejamiento de Christofides: --emparejamiento=auto|exacto|voraz
+    emparejamientoTSP = opcionDe(argc, argv, "emparejamiento", "auto", {"auto", "exacto", "voraz"});
+    memoriaMaximaTSP = stoull(opcion(argc, argv, "memoria-mb", "1024")) << 20;
+    // Cota inferior del branch and bound: --cota=simple|unoarbol|lagrange. Las penalizaciones son opcionales,
+    // pero quedan por omisión: se calculan una sola vez en la raíz y en instancias euclidianas de 20 a 30
+    // nodos el 1-árbol penalizado termina de 6 a 75 veces antes que el simple
+    string cota = opcionDe(argc, argv, "cota", "lagrange", {"simple", "unoarbol", "lagrange"});
+    cotaTSP = cota == "simple" ? COTA_SIMPLE : cota == "unoarbol" ? COTA_UNO_ARBOL : COTA_LAGRANGE;
+    // Kernel del branch and bound: --kernel=fijo (bitset y matriz plana hasta N = 256) o generico
+    kernelFijo = opcionDe(argc, argv, "kernel", "fijo", {"fijo", "generico"}) != "generico";
+    // Instrucciones vectoriales para los mínimos de la cota simple y la malla de Voronoi: --simd=auto|avx512|avx2|escalar
+    simdTSP = opcionDe(argc, argv, "simd", "auto", {"auto", "avx512", "avx2", "escalar"});
+    // Orden de la búsqueda del branch and bound: --busqueda=profundidad|mejor (mejor primero con la cola
+    // acotada por --memoria-mb; al llenarse termina en profundidad). El costo es el mismo, pero entre
+    // recorridos empatados la búsqueda mejor primero no siempre da el primero en orden lexicográfico.
+    busquedaTSP = opcionDe(argc, argv, "busqueda", "profundidad", {"profundidad", "mejor"}) == "mejor" ? BUSQUEDA_MEJOR : BUSQUEDA_PROFUNDIDAD;
+    // Ramificación del branch and bound: --ramificacion=indice|cercanos (exactas) o candidatos (heurística,
+    // solo con los --candidatos=k vecinos más cercanos o, con coordenadas, --candidatos=delaunay)
+    string ramificacion = opcionDe(argc, argv, "ramificacion", "indice", {"indice", "cercanos", "candidatos"});
+    ramificacionTSP = ramificacion == "cercanos" ? RAMIFICACION_CERCANOS : ramificacion == "candidatos" ? RAMIFICACION_CANDIDATOS
+                                                                                                           : RAMIFICACION_INDICE;
+    string candidatos = opcion(argc, argv, "candidatos", "8");
+    if (candidatos != "delaunay")
+    {
+        numCandidatos = max(1, stoi(candidatos));
+    }
+    // Etiquetado de la malla de Voronoi: --voronoi=auto|edt (transformada de distancia, O(malla)), kd (árbol
+    // k-d, O(malla log N)), simd (todas las centrales, 8 o 16 por instrucción) o fuerza (O(malla * N));
+    // "auto" elige según N y el ancho del área
+    motorVoronoi = opcionDe(argc, argv, "voronoi", "auto", {"auto", "edt", "kd", "simd", "fuerza"});
+    pasoVoronoi = max(1, stoi(opcion(argc, argv, "paso-voronoi", "10")));
+    // Polígonos de Voronoi: --celdas=malla (muestreo de la malla y RDP) o exactas (recorte por semiplanos,
+    // vértices con dos decimales; no usa la malla)
+    celdasVoronoi = opcionDe(argc, argv, "celdas", "malla", {"malla", "exactas"});
+    // Puntos de cada polígono de la malla: --contorno=frontera (muestras con una vecina de 8 de otra celda,
+    // ordenadas por su envolvente convexa) o muestras (todas las de la celda, ordenadas por ángulo)
+    contornoVoronoi = opcionDe(argc, argv, "contorno", "frontera", {"frontera", "muestras"});
+    // Tabla de transposición de la búsqueda en profundidad (N <= 64): memoria máxima en MB, 0 la apaga
+    memoriaTablaTSP = stoull(opcion(argc, argv, "tabla-mb", "64")) << 20;
+    // Modo anytime: --tiempo-ms=T entrega la respuesta del TSP antes de T ms desde que empieza a resolverse
+    // (sin contar la lectura de la entrada ni el MST). La brecha contra la cota inferior se mide mejor con
+    // la cota de Lagrange, así que se usa esa.
+    presupuestoMs = stoll(opcion(argc, argv, "tiempo-ms", "0"));
+    if (presupuestoMs > 0)
+    {
+        conFechaLimite = true;
+        cotaTSP = COTA_LAGRANGE;
+        // Held-Karp y Christofides no revisan el reloj, así que no pueden prometer terminar a tiempo
+        if (motorTSP == "heldkarp" || motorTSP == "christofides")
+        {
+            cerr << "--tiempo-ms no se puede usar con --tsp=" << motorTSP << " (no se puede interrumpir)" << endl;
+            return 1;
+        }
+    }
+    // Actualizaciones de costos de fibra al final de la entrada: --mst-dinamico=si|no
+    bool mstDinamico = opcionDe(argc, argv, "mst-dinamico", "no", {"si", "no"}) == "si";
+    if (!opcionesValidas)
+    {
+        return 1;
+    }
 
     cout << -1 << endl;
-    int N;
     cin >> N;
 
-    vector<Arista> aristas;
-
-    // Leer matriz de adyacencia de distancias
-    for (int i = 0; i < N; ++i)
+    // Leer matriz de adyacencia de distancias en un arreglo plano (fila mayor)
+    // Solo se toman las aristas no repetidas (i < j); la parte inferior se refleja de la superior
+    vector<int> matriz(soloCoordenadas ? 0 : (size_t)N * N);
+    for (int i = 0; i < N && !soloCoordenadas; ++i)
     {
         for (int j = 0; j < N; ++j)
         {
             int distancia;
             cin >> distancia;
 
-            // Añadir aristas no repetidas con peso de la distancia
-            if (i < j)
+            if (i <= j)
             {
-                aristas.emplace_back(i, j, distancia);
+                matriz[(size_t)i * N + j] = distancia;
+            }
+            else
+            {
+                matriz[(size_t)i * N + j] = matriz[(size_t)j * N + i];
             }
         }
     }
@@ -392,7 +4355,7 @@ int main()
     // ----------------------------------------------------------------
 
     // Encontrar conexiones óptimas de colonias con fibra óptica
-    vector<Arista> mst = kruskal(N, aristas);
+    vector<Arista> mst = arbolExpansionMinimo(motorMST, N, matriz, centrales);
 
     // Imprimir resultado
     vector<int> pesos;
@@ -416,25 +4379,49 @@ int main()
     ***************************
     ***************************
     */
-    // primer valor es el tamaño de la matriz, el segundo valor es el valor default de cada posiscion
-    dist = vector<vector<int>>(N, vector<int>(N)); // Inicializa la matriz de distancias
-    visitado = vector<bool>(N, false);             // Inicializa el vector de visitados
-    camino = vector<int>(N);                       // Inicializa el vector de camino
-    caminoMin = vector<int>(N);                    // Inicializa el vector del camino mínimo
-
-    // Recibe la matriz de distancias
-    for (int i = 0; i < N; i++)
+    if (soloCoordenadas && motorTSP == "christofides")
     {
-        for (int j = 0; j < N; j++)
+        // Sin matriz de distancias: se reutiliza el MST euclidiano de arriba, así escala a cientos de miles
+        inicializarTSP(N);
+        long long costo;
+        caminoMin = recorridoChristofidesCoordenadas(centrales, mst, costo);
+        costoMinimo = (int)costo;
+    }
+    else
+    {
+        // Candidatos de la ramificación: los vecinos de cada central en la triangulación de Delaunay
+        if (soloCoordenadas && candidatos == "delaunay")
         {
-            cin >> dist[i][j];
+            candidatosExternos.assign(N, {});
+            for (const Arista &arista : aristasDelaunay(centrales))
+            {
+                candidatosExternos[arista.nodoA].push_back(arista.nodoB);
+                candidatosExternos[arista.nodoB].push_back(arista.nodoA);
+            }
         }
-    }
 
-    camino[0] = 0; // El primer nodo visitado es el 0
-    visitado[0] = true;
+        // primer valor es el tamaño de la matriz, el segundo valor es el valor default de cada posiscion
+        dist = vector<vector<int>>(N, vector<int>(N)); // Inicializa la matriz de distancias
+        inicializarTSP(N);                             // Inicializa visitados, camino y camino mínimo
+
+        // Recibe la matriz de distancias (o la calcula de las coordenadas)
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                if (soloCoordenadas)
+                {
+                    dist[i][j] = pesoEuclidiano(centrales[i], centrales[j]);
+                }
+                else
+                {
+                    cin >> dist[i][j];
+                }
+            }
+        }
 
-    TSP(1); // Comenzamos desde el nodo 1
+        resolverTSP(motorTSP);
+    }
 
     // Imprime el costo mínimo y el camino mínimo
     cout << -2 << endl;
@@ -464,5 +4451,48 @@ int main()
 
     voronoi(centrales, xmin, ymin, xmax, ymax);
 
+    // Actualizaciones de costos de fibra (--mst-dinamico): después de la entrada normal llegan lotes
+    // "K" seguido de K líneas "a b w". Por cada lote se imprime -5, el nuevo peso total del árbol y
+    // las aristas que salieron (-) y entraron (+) en neto durante el lote
+    if (mstDinamico)
+    {
+        if (soloCoordenadas)
+        {
+            matriz.resize((size_t)N * N);
+            for (int i = 0; i < N; ++i)
+                for (int j = 0; j < N; ++j)
+                    matriz[(size_t)i * N + j] = pesoEuclidiano(centrales[i], centrales[j]);
+        }
+        MSTDinamico dinamico(N, move(matriz));
+        int K;
+        while (cin >> K)
+        {
+            vector<Arista> salieron, entraron;
+            for (int k = 0; k < K; ++k)
+            {
+                int a = -1, b = -1, w = 0;
+                cin >> a >> b >> w;
+                if (!cin || a < 0 || a >= N || b < 0 || b >= N || a == b)
+                {
+                    cerr << "actualización inválida: " << a << " " << b << " (se esperan dos nodos distintos en [0, " << N << "))" << endl;
+                    return 1;
+                }
+                dinamico.actualizar(a, b, w, salieron, entraron);
+            }
+            MSTDinamico::cambioNeto(salieron, entraron);
+            cout << -5 << endl;
+            cout << dinamico.pesoTotal << endl;
+            for (const Arista &arista : salieron)
+            {
+                cout << "- " << arista.nodoA << " " << arista.nodoB << " " << arista.peso << endl;
+            }
+            for (const Arista &arista : entraron)
+            {
+                cout << "+ " << arista.nodoA << " " << arista.nodoB << " " << arista.peso << endl;
+            }
+        }
+    }
+
     return 0;
 }
+#endif
@@ -5,7 +5,11 @@
 #include <unordered_set>
 #include <utility>
 #include <algorithm>
+#include <string>
 
+// Todo el algoritmo vive en el namespace delaunay para que main.cpp pueda incluir este archivo
+// (definiendo DELAUNAY_SIN_MAIN) sin chocar con su propia estructura Arista ni sus globales
+namespace delaunay {
 
 const int INF = 1e9; // Representa un valor infinito
 
@@ -19,7 +23,6 @@ class Point {
         // metodos que inicializan un objeto Point()
         Point();
         Point(double, double);
-        Point(const Point&);
 
         // metodos para obtener los valroes de x y y
         double getX() const;
@@ -44,11 +47,6 @@ Point::Point(double x, double y) {
     this->y = y;
 }
 
-Point::Point(const Point& p) {
-    x = p.x;
-    y = p.y;
-}
-
 double Point::getX() const {
     return x;
 }
@@ -61,10 +59,13 @@ std::string Point::obtenerXY() const {
     return std::to_string(x) + " " + std::to_string(y);
 }
 
+} // namespace delaunay
+
 // Definición de la función hash para Point. Necesario para funcion hash de <Point>
 namespace std {
     template<>
-    struct hash<Point> {
+    struct hash<delaunay::Point> {
+        using Point = delaunay::Point;
         std::size_t operator()(const Point& p) const {
             std::size_t h1 = std::hash<double>()(p.getX());
             std::size_t h2 = std::hash<double>()(p.getY());
@@ -73,6 +74,8 @@ namespace std {
     };
 }
 
+namespace delaunay {
+
 // clase Arista
 class Arista {
     private: 
@@ -108,10 +111,14 @@ Point Arista::getP2() const {
     return p2;
 }
 
+} // namespace delaunay
+
 // definicion de la funcion hash para la clase arista para crear un unordered set
 namespace std {
     template <>
-    struct hash<Arista> {
+    struct hash<delaunay::Arista> {
+        using Arista = delaunay::Arista;
+        using Point = delaunay::Point;
         size_t operator()(const Arista& a) const {
             // Obtenemos los hashes de cada punto
             size_t h1 = hash<Point>{}(a.getP1());
@@ -124,6 +131,7 @@ namespace std {
     };
 }
 
+namespace delaunay {
 
 class Triangulo { 
     private:
@@ -239,236 +247,118 @@ double distanciaDosPuntos(const Point &p1, const Point &p2) {
 }
 
 /**********
-Objetivo: Función para saber si una arista se encuentra en el vector de triangulos_invalidos
-Entradas: Una arista y el vector<Triangulo> de triangulos_invalidos
-Salidas: True si se encuentra la arista en triangulos invalidos, false si no se encuentra
-Complejidad: O(t) donde t es el numero de triangulos
+Objetivo: Función para obtener la triangulación de Delaunay de un conjunto de puntos (Bowyer-Watson)
+Entradas: El vector de puntos
+Salidas: Los triangulos de la triangulación, incluyendo los que tocan los vertices del super triangulo
+Complejidad: O(n^1.5) en promedio para puntos distribuidos uniformemente. Los puntos se insertan
+             ordenados por x, y un triangulo cuyo circuncirculo ya quedo a la izquierda del punto actual
+             nunca se vuelve a invalidar, asi que sale de la lista de triangulos abiertos.
 ***********/
-bool arista_en_triangulosInvalidos (const Arista& arista, const std::vector<Triangulo>& triangulos_invalidos) {
-    // aqui se obtienen los edges del triangulo y por cada arista obtenida se va comparando si pi y pj son iguales o no
-    for (const auto& triangulo : triangulos_invalidos) {
-        std::vector<Arista> aristas_vector = triangulo.getAristas();
-        for (const auto& a : aristas_vector) {
-            if (arista == a) { // se regresa true si la arista es parte de una arista en triangulos invalidos
-                return true;
-            }
-        }
-    }
-    return false; // Los puntos no forman una arista en ningún triángulo
-}
-
-/**********
-Objetivo: Función para saber si una arista se encuentra en el vector de aristas_comunes
-Entradas: Una arista y el vector<Arista> de aristas_comunes
-Salidas: True si se encuentra la arista en triangulos invalidos, false si no se encuentra
-Complejidad: O(a) donde a es el numero de aristas en aristas comunes
-***********/
-bool arista_en_aristasComunes (const Arista& arista, const std::vector<Arista>& aristas_comunes) {
-    for (const auto& arista_comun : aristas_comunes) {
-        if (arista == arista_comun) {
-            return true; // si se encontro la arista en aristas comunes, regresar true de que se encontro
-        }
-    }
-    return false; // regresar false si no se encontro nada
-}
-
-
-
-/**********
-Objetivo: Función para saber si la arista es una arista de triangulos_invalidos y si esta arista no esta en aristas_comunes
-Entradas: Una arista, vetor triangulos_invalidos, vector aristas_comunes
-Salidas: True si se encuentra la arista en triangulos invalidos, false si no se encuentra
-Complejidad: O(a + t) donde a es el numero de aristas en aristas comunes y t es el numero de triangulos en triangulos_invalidos
-***********/
-bool confirmacion_arista(const Arista& arista,const std::vector<Triangulo>& triangulos_invalidos, const std::vector<Arista>& aristas_comunes) { 
-    if (arista_en_triangulosInvalidos(arista, triangulos_invalidos) && !arista_en_aristasComunes(arista, aristas_comunes)) {
-        return true; // si se cumple la condicion, regresa true
-    }
-    return false; // regresa false si no se cumple la condicion
-}
-
-
 std::vector<Triangulo> delaunay_triangulation(std::vector<Point>& puntos) { 
-    // 1. se forma el super_triangulo. El primer triangulo en DT
-    int minx = INF;
-    int maxx = 0;
-    int miny = INF;
-    int maxy = 0;
-
-    for (const auto& elemento : puntos) {
-        // se obtiene minx y maxx
-        if (elemento.getX() < minx) {
-            minx = elemento.getX();
-        }
-        if (elemento.getX() > maxx) {
-            maxx = elemento.getX();
-        }
+    // triangulo por indices de vertice, con su circuncirculo guardado para no recalcularlo
+    struct TrianguloIdx {
+        int a, b, c;
+        double cx, cy, r2;
+    };
 
-        // se obtiene miny y maxy
-        if (elemento.getY() < miny) {
-            miny = elemento.getY();
-        }
-        if (elemento.getY() > maxy) {
-            maxy = elemento.getY();
-        }
-        
+    // 1. se ordenan los puntos por x (y luego y) y se eliminan los repetidos
+    std::vector<Point> vertices(puntos);
+    std::sort(vertices.begin(), vertices.end(), [](const Point& p, const Point& q) {
+        return p.getX() < q.getX() || (p.getX() == q.getX() && p.getY() < q.getY());
+    });
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+    int n = vertices.size();
+    if (n == 0) {
+        return {};
     }
-    int distx = maxx - minx;
-    int disty = maxy - miny;
-
-    // se crea el super triangulo
-    Triangulo super_triangulo = Triangulo(
-        Point(minx - (9.5*distx), miny + (0.5*disty)),
-        Point(minx + (5.5*distx), miny + (9.16*disty)),
-        Point(minx + (5.5*distx), miny - (8.16*disty))
-    );
-
-    // 2. Estructura de datos para triangluos creados. El primer triangulo es incluido. 
-    std::vector<Triangulo> triangulos_DT;
-    std::vector<Triangulo> triangulos_invalidos;
 
-    triangulos_DT.push_back(super_triangulo);
-
-    // se agregan todos los puntos a la queue
-    // para obtener un valor de la queue se necesita getX(), getY(), o mostrarCY()
-    std::queue<Point> listaPuntos;
-
-    // se agregan todos los puntos del vecotr a la queue
-    for (const auto& punto : puntos) {
-        listaPuntos.push(punto);
+    // 2. se forma el super_triangulo, que contiene a todos los puntos con mucho margen
+    double minx = vertices.front().getX();
+    double maxx = vertices.back().getX();
+    double miny = vertices[0].getY();
+    double maxy = vertices[0].getY();
+    for (const auto& elemento : vertices) {
+        miny = std::min(miny, elemento.getY());
+        maxy = std::max(maxy, elemento.getY());
     }
+    double delta = std::max(1.0, std::max(maxx - minx, maxy - miny));
+    double midx = (minx + maxx) / 2;
+    double midy = (miny + maxy) / 2;
+    vertices.push_back(Point(midx - 20 * delta, midy - delta));
+    vertices.push_back(Point(midx, midy + 20 * delta));
+    vertices.push_back(Point(midx + 20 * delta, midy - delta));
+
+    // se crea un triangulo por indices calculando su circuncentro y circunradio al cuadrado
+    auto crear = [&vertices](int a, int b, int c) {
+        Point centro = Triangulo(vertices[a], vertices[b], vertices[c]).getCircunCentro();
+        double dx = vertices[a].getX() - centro.getX();
+        double dy = vertices[a].getY() - centro.getY();
+        return TrianguloIdx{a, b, c, centro.getX(), centro.getY(), dx * dx + dy * dy};
+    };
 
-    // 5. Ahora se crea un unordered_set de puntos invalidos
-    //std::cout << "ENTRO AL PASO 5" << std::endl;
-    std::unordered_set<Point> puntos_invalidos_set;
-    std::vector<Point> puntos_invalidos;
-
-    //se crea un vector de aristas comunes
-    // punto p1, punto p2
-    std::vector<Arista> aristas_comunes;
-    std::unordered_set<Arista> aristas_comunes_set; // se crea un unordered set
-
-    // 3. Se checa si hay un punto a agregar.
-    while (!listaPuntos.empty()) {
-        Point punto = listaPuntos.front(); // se otbiene el punto que esta al frente de la lista
-        listaPuntos.pop(); // se elimina el punto al frente de la lista
-        //std::cout << "Punto: " << punto.obtenerXY() << std::endl;
-        // 4. Se itera sobre triangulos_DT
-        for (const auto& triangulo : triangulos_DT) {
-            //std::cout << "ENTRO AL PASO 4" << std::endl;
-            // 4a - 4b: Encontrar circuncentro y curcunradio y determinar la distancia entre punto y circuncentro
-            double distancia_punto_circuncentro = distanciaDosPuntos(punto,triangulo.getCircunCentro()); // distancia entre centro del ciruclo y el punto
-            
-            //std::cout << "Triangulo: " << triangulo.getCircunCentro().obtenerXY() << std::endl;
-            //std::cout << "Circuncentro: " << triangulo.getCircunCentro().obtenerXY() << std::endl;
-            //std::cout << "Circunradio: " << triangulo.getCircunRadio() << std::endl;
-            //std::cout << "DistanciaPuntos: " << distancia_punto_circuncentro << std::endl;
-
-            // 4c. Si la distnacia es menor que el circunradio, se guarda triangulo actual en triangulos_invalidos
-            if (distancia_punto_circuncentro < triangulo.getCircunRadio()) {
-                triangulos_invalidos.push_back(triangulo); // se guarda en vector triangulos invalidos
-                //std::cout << "Se hizo pushback: " << std::endl;
-                //triangulos_invalidos[0].mostrarPuntos();
+    std::vector<TrianguloIdx> abiertos = {crear(n, n + 1, n + 2)};
+    std::vector<TrianguloIdx> cerrados;
+    std::vector<TrianguloIdx> siguientes;
+    std::vector<std::pair<int, int>> aristas_cavidad;
+
+    // 3. se agrega cada punto
+    for (int idx = 0; idx < n; idx++) {
+        double px = vertices[idx].getX();
+        double py = vertices[idx].getY();
+        siguientes.clear();
+        aristas_cavidad.clear();
+
+        // 4. se separan los triangulos cuyo circuncirculo contiene al punto (invalidos)
+        for (const auto& t : abiertos) {
+            double dx = px - t.cx;
+            double dy = py - t.cy;
+            if (dx > 0 && dx * dx > t.r2) {
+                cerrados.push_back(t); // el circulo quedo a la izquierda: ya no cambia
+            } else if (dx * dx + dy * dy < t.r2) {
+                // se guardan las aristas del triangulo invalido con el indice menor primero
+                aristas_cavidad.push_back({std::min(t.a, t.b), std::max(t.a, t.b)});
+                aristas_cavidad.push_back({std::min(t.b, t.c), std::max(t.b, t.c)});
+                aristas_cavidad.push_back({std::min(t.c, t.a), std::max(t.c, t.a)});
+            } else {
+                siguientes.push_back(t);
             }
-
         }
 
-        // 6. se recorre el vector de triangulos invalidos
-        for (int idx = 0; idx < triangulos_invalidos.size(); idx++) {
-            //std::cout << "ENTRO AL PASO 6" << std::endl;
-            //6a
-            aristas_comunes.erase(aristas_comunes.begin(), aristas_comunes.end());
-            // se recorre el arreglo de triangulos_invalidos y checa cuales aristas son similares.
-            for (int jdx = 0; jdx < triangulos_invalidos.size(); jdx++) {
-
-                // cuando los triangulos son diferentes
-                if (idx != jdx) {
-                    // se guardan en aristasT1 y aristasT2 un vector<pair<Point, Point>>. 
-                    // es un vector donde se tiene un par de puntos que son las aristas
-                    auto aristasT1 = triangulos_invalidos[idx].getAristas();
-                    auto aristasT2 = triangulos_invalidos[jdx].getAristas();
-
-                    // se recorren los dos vectores de las aristas y se comparan
-                    for (auto& arista1 : aristasT1) {
-                        for (auto& arista2 : aristasT2) {
-                            // en este if se checa si se tiene una arista en comun. 
-                            if (arista1 == arista2) {
-                                //std::cout << "Se encontro arista en comun" << std::endl;
-
-                                // cuando se tiene una arist en comun
-                                aristas_comunes_set.insert(arista1); // se guarda la arista en aristas_comunes
-                                // en la siguiente linea, se elimina triangulos_invalidos[idx] de triangulos_dt
-                                triangulos_DT.erase(
-                                    std::remove_if(
-                                        triangulos_DT.begin(),
-                                        triangulos_DT.end(),
-                                        [&triangulos_invalidos, &idx](const Triangulo& t) { return t == triangulos_invalidos[idx]; }
-                                    ),
-                                    triangulos_DT.end()
-                                );
-                                
-                            }
-                        }
-                    }
-
-
-                }
+        // 5. las aristas que solo aparecen en un triangulo invalido forman el borde de la cavidad,
+        // y cada una se une con el punto nuevo para formar un triangulo
+        std::sort(aristas_cavidad.begin(), aristas_cavidad.end());
+        for (size_t jdx = 0; jdx < aristas_cavidad.size();) {
+            size_t kdx = jdx;
+            while (kdx < aristas_cavidad.size() && aristas_cavidad[kdx] == aristas_cavidad[jdx]) {
+                kdx++;
             }
-
-            //6b. se agrega a puntos_invalidos_set todo los vertices de los triangulos de triangulos_invalidos
-            puntos_invalidos_set.insert(triangulos_invalidos[idx].getA()); // inserta primer vertice
-            puntos_invalidos_set.insert(triangulos_invalidos[idx].getB()); // inserta segundo vertice
-            puntos_invalidos_set.insert(triangulos_invalidos[idx].getC()); // inserta tercer vertice
-        }
-
-        // se recorre el unordered_set de puntos invalidos y se inserta en un vector. Esto es necesario para paso 7
-        for (const auto& punto_invalido : puntos_invalidos_set) {
-            puntos_invalidos.push_back(punto_invalido);
-            //std::cout << punto_invalido.obtenerXY() << std::endl;
-        }
-
-        for (const auto& arista_comu : aristas_comunes_set) {
-            aristas_comunes.push_back(arista_comu);
-            //std::cout << arista_comu.getP1().obtenerXY() << " " << arista_comu.getP2().obtenerXY() << std::endl;
-        }
-
-        /*std::cout << "ENTRO AL PASO 7" << std::endl;
-        std::cout << puntos_invalidos.size() << std::endl;
-        std::cout << triangulos_invalidos.size() << std::endl;
-        std::cout << aristas_comunes.size() << std::endl;*/
-
-
-        //7. Se recorren los puntos invalidos
-            for (int idx = 0; idx < puntos_invalidos.size()  - 1; idx++) {
-                for (int jdx = idx + 1; jdx < puntos_invalidos.size(); jdx++) {
-                    if (confirmacion_arista(Arista(puntos_invalidos[idx], puntos_invalidos[jdx]), triangulos_invalidos, aristas_comunes)) {
-                        Triangulo nuevo_triangulo = Triangulo(puntos_invalidos[idx], puntos_invalidos[jdx], punto); // se forma el nuevo triangulo con los nuevos puntos
-                        triangulos_DT.push_back(nuevo_triangulo); // se inserta el nuevo triangulo al vector de trianguos_DT
-                        //std::cout << "Triangulo: ";
-                        //triangulos_DT[triangulos_DT.size() - 1].mostrarPuntos();
-                    }
-                }
+            if (kdx - jdx == 1) {
+                siguientes.push_back(crear(aristas_cavidad[jdx].first, aristas_cavidad[jdx].second, idx));
             }
+            jdx = kdx;
+        }
+        abiertos.swap(siguientes);
+    }
 
-            //std::cout << "ENTRO AL PASO 8" << std::endl;
-            // se aseguran que las siguientes estructuras esten siendo borradas antes de empezar el siguiente ciclo
-            triangulos_invalidos.erase(triangulos_invalidos.begin(), triangulos_invalidos.end());
-            puntos_invalidos.erase(puntos_invalidos.begin(), puntos_invalidos.end());
-            aristas_comunes.erase(aristas_comunes.begin(), aristas_comunes.end());
-            aristas_comunes_set.clear();
-            puntos_invalidos_set.clear();
+    // 6. se regresan todos los triangulos como objetos Triangulo
+    cerrados.insert(cerrados.end(), abiertos.begin(), abiertos.end());
+    std::vector<Triangulo> triangulos_DT;
+    triangulos_DT.reserve(cerrados.size());
+    for (const auto& t : cerrados) {
+        triangulos_DT.push_back(Triangulo(vertices[t.a], vertices[t.b], vertices[t.c]));
     }
     return triangulos_DT;
 }
 
+#ifndef DELAUNAY_SIN_MAIN
 void voronoi_diagram(std::vector<Point>& puntos) {
     //1. Encontrar triangulos_DT de delaunay
     std::vector<Triangulo> triangulos_DT = delaunay_triangulation(puntos);
     
     std::unordered_set<Point> puntos_validos;
     // se recorren todos los triangulos
-    for (int idx = 0; idx < triangulos_DT.size() - 1; idx++) {
-        for (int jdx = idx + 1; jdx < triangulos_DT.size(); jdx++) {
+    for (size_t idx = 0; idx + 1 < triangulos_DT.size(); idx++) {
+        for (size_t jdx = idx + 1; jdx < triangulos_DT.size(); jdx++) {
 
             auto aristasT1 = triangulos_DT[idx].getAristas(); // se obtienen aristas del triangulo 1
             auto aristasT2 = triangulos_DT[jdx].getAristas(); // se obtienen aristas del triangulo 2
@@ -492,8 +382,14 @@ void voronoi_diagram(std::vector<Point>& puntos) {
     }
     
 }
+#endif
+
+} // namespace delaunay
 
+#ifndef DELAUNAY_SIN_MAIN
 int main() {
+    using namespace delaunay;
+
     std::cin >> N;
     puntos = std::vector<Point>(N); // inicializa el vector con los puntos
 
@@ -509,6 +405,7 @@ int main() {
 
     return 0;
 }
+#endif
 /*
 input:
 10